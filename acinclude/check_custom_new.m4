@@ -1,16 +1,24 @@
 AC_DEFUN([CHECK_CUSTOM_NEW], [
 
-# custom new off by default, contributing to problems with sst-core thread parallel simulation
+# custom new is on by default for the native backends, but off by default with sst-core
+# since it contributes to problems with sst-core thread parallel simulation
 AC_ARG_ENABLE([custom-new],
   [AS_HELP_STRING([--(dis|en)able-custom-new],
-    [enable custom new on certain classes for efficient, thread-safe mem pools [default=disable]])],
+    [enable custom new on certain classes for efficient, thread-safe mem pools [default=enable without sst-core]])],
   [with_custom_new=$enableval],
-  [with_custom_new=no]
+  [with_custom_new=default]
 )
 
+if test "X$with_custom_new" = "Xdefault"; then
+  if test "X$have_integrated_core" = "Xyes"; then
+    with_custom_new=no
+  else
+    with_custom_new=yes
+  fi
+fi
+
 if test "X$with_custom_new" = "Xyes"; then
-  AC_DEFINE_UNQUOTED([CUSTOM_NEW], 1, [Track communcation synchronization stats])
+  AC_DEFINE_UNQUOTED([CUSTOM_NEW], 1, [Use thread-safe memory pools for frequently allocated objects])
 fi
 
 ])
-
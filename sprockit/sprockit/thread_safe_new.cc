@@ -0,0 +1,107 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#define __STDC_FORMAT_MACROS
+#include <sprockit/thread_safe_new.h>
+#include <sprockit/spkt_printf.h>
+#include <cinttypes>
+#include <cxxabi.h>
+#include <cstdlib>
+#include <mutex>
+#include <ostream>
+
+namespace sprockit {
+
+static std::vector<ThreadAllocatorSet*>& allocatorSets()
+{
+  static std::vector<ThreadAllocatorSet*> sets;
+  return sets;
+}
+
+static std::mutex& allocatorSetLock()
+{
+  static std::mutex lock;
+  return lock;
+}
+
+void
+ThreadAllocatorSet::registerSet(ThreadAllocatorSet* set, const char* name, size_t unitSize)
+{
+  std::lock_guard<std::mutex> guard(allocatorSetLock());
+  if (set->registered) return;
+
+  set->type_name = name;
+  set->unit_size = unitSize;
+  set->registered = true;
+  allocatorSets().push_back(set);
+}
+
+void
+ThreadAllocatorSet::printStats(std::ostream& os)
+{
+  std::lock_guard<std::mutex> guard(allocatorSetLock());
+  os << "Memory pool high-water marks:\n";
+  for (ThreadAllocatorSet* set : allocatorSets()){
+    uint64_t units = 0;
+    uint64_t free_units = 0;
+    int nthread = 0;
+    for (int t=0; t < MAX_NUM_NEW_SAFE_THREADS; ++t){
+      if (set->num_units[t]){
+        units += set->num_units[t];
+        ++nthread;
+      }
+      //frees on other threads can leave units on a thread that never grew
+      free_units += set->available[t].size();
+    }
+
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(set->type_name, nullptr, nullptr, &status);
+    const char* name = status == 0 ? demangled : set->type_name;
+    os << sprockit::sprintf("  %s: %" PRIu64 " objects (%" PRIu64 " KB) on %d threads, %" PRIu64 " in use at end\n",
+                            name, units, units * set->unit_size / 1024, nthread, units - free_units);
+    if (demangled) ::free(demangled);
+  }
+}
+
+}
@@ -46,7 +46,11 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <vector>
 #include <set>
+#include <iosfwd>
+#include <typeinfo>
+#include <cstdint>
 #include <sstmac/common/sstmac_config.h>
+#include <sprockit/errors.h>
 
 #define SPKT_TLS_OFFSET 64
 
@@ -78,6 +82,20 @@ struct ThreadAllocatorSet {
 #define MAX_NUM_NEW_SAFE_THREADS 128
   std::vector<char*> allocations[MAX_NUM_NEW_SAFE_THREADS];
   std::vector<void*> available[MAX_NUM_NEW_SAFE_THREADS];
+  /** Pools never shrink, so the number of units is the high-water mark */
+  uint64_t num_units[MAX_NUM_NEW_SAFE_THREADS];
+  const char* type_name;
+  size_t unit_size;
+  bool registered;
+
+  ThreadAllocatorSet() :
+    num_units{},
+    type_name(nullptr),
+    unit_size(0),
+    registered(false)
+  {
+  }
+
   ~ThreadAllocatorSet(){
     for (int i=0; i < MAX_NUM_NEW_SAFE_THREADS; ++i){
       auto& vec = allocations[i];
@@ -86,6 +104,17 @@ struct ThreadAllocatorSet {
       }
     }
   }
+
+  /**
+   * @brief registerSet Add a pool to the list reported by printStats.
+   *        Done the first time a pool grows so unused types are not listed.
+   */
+  static void registerSet(ThreadAllocatorSet* set, const char* name, size_t unitSize);
+
+  /**
+   * @brief printStats Print the high-water mark of each memory pool
+   */
+  static void printStats(std::ostream& os);
 };
 
 template <class T>
@@ -178,6 +207,10 @@ class thread_safe_new {
 #endif
     }
     alloc_.allocations[thread].push_back(newTs);
+    alloc_.num_units[thread] += numElems;
+    if (!alloc_.registered){
+      ThreadAllocatorSet::registerSet(&alloc_, typeid(T).name(), unitSize);
+    }
   }
 
  private:
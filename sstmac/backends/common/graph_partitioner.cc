@@ -0,0 +1,481 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+
+#include <sstmac/backends/common/graph_partitioner.h>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <set>
+
+namespace sstmac {
+
+int64_t
+GraphPartitioner::Graph::totalWeight() const
+{
+  return std::accumulate(vwgt.begin(), vwgt.end(), int64_t(0));
+}
+
+GraphPartitioner::Graph
+GraphPartitioner::Graph::build(const std::vector<int64_t>& vwgt,
+                               const std::map<std::pair<int,int>,int64_t>& edges)
+{
+  Graph g;
+  int n = vwgt.size();
+  g.vwgt = vwgt;
+  g.xadj.resize(n+1, 0);
+  for (auto& pair : edges){
+    if (pair.first.first == pair.first.second) continue;
+    ++g.xadj[pair.first.first+1];
+    ++g.xadj[pair.first.second+1];
+  }
+  for (int v=0; v < n; ++v){
+    g.xadj[v+1] += g.xadj[v];
+  }
+  g.adjncy.resize(g.xadj[n]);
+  g.adjwgt.resize(g.xadj[n]);
+  std::vector<int> next(g.xadj.begin(), g.xadj.end()-1);
+  for (auto& pair : edges){
+    int v = pair.first.first;
+    int u = pair.first.second;
+    if (u == v) continue;
+    g.adjncy[next[v]] = u;
+    g.adjwgt[next[v]++] = pair.second;
+    g.adjncy[next[u]] = v;
+    g.adjwgt[next[u]++] = pair.second;
+  }
+  return g;
+}
+
+GraphPartitioner::GraphPartitioner(double max_imbalance, uint32_t seed) :
+  max_imbalance_(max_imbalance),
+  rng_(seed)
+{
+}
+
+std::vector<int>
+GraphPartitioner::partition(const Graph& g, int nparts)
+{
+  std::vector<int> part(g.numVertices(), 0);
+  if (nparts <= 1 || g.numVertices() == 0){
+    return part;
+  }
+
+  //split the allowed imbalance evenly across the levels of bisection
+  int depth = std::ceil(std::log2(nparts));
+  double ubfactor = std::pow(1.0 + max_imbalance_, 1.0/depth);
+  std::vector<int> ids(g.numVertices());
+  std::iota(ids.begin(), ids.end(), 0);
+  recursiveBisect(g, ids, nparts, 0, ubfactor, part);
+  return part;
+}
+
+void
+GraphPartitioner::recursiveBisect(const Graph& g, const std::vector<int>& ids,
+                                  int nparts, int first_part, double ubfactor,
+                                  std::vector<int>& part)
+{
+  if (nparts == 1 || g.numVertices() <= 1){
+    for (int id : ids){
+      part[id] = first_part;
+    }
+    return;
+  }
+
+  int left = nparts / 2;
+  std::vector<int> side = bisect(g, double(left) / nparts, ubfactor);
+  for (int which=0; which < 2; ++which){
+    std::vector<int> sub_ids;
+    Graph sub = subgraph(g, side, which, sub_ids);
+    for (int& id : sub_ids){
+      id = ids[id];
+    }
+    if (which == 0){
+      recursiveBisect(sub, sub_ids, left, first_part, ubfactor, part);
+    } else {
+      recursiveBisect(sub, sub_ids, nparts - left, first_part + left, ubfactor, part);
+    }
+  }
+}
+
+std::vector<int>
+GraphPartitioner::bisect(const Graph& g, double frac, double ubfactor)
+{
+  //deque so that references to coarser levels stay valid as more are added
+  std::deque<Graph> levels;
+  std::vector<std::vector<int>> cmaps;
+  const Graph* cur = &g;
+  while (cur->numVertices() > coarsen_to_){
+    std::vector<int> cmap;
+    Graph coarse = coarsen(*cur, cmap);
+    if (coarse.numVertices()*20 > cur->numVertices()*19){
+      break; //matching is no longer shrinking the graph
+    }
+    cmaps.push_back(std::move(cmap));
+    levels.push_back(std::move(coarse));
+    cur = &levels.back();
+  }
+
+  std::vector<int> side = growBisection(*cur, frac, ubfactor);
+  for (int l=int(levels.size())-1; l >= 0; --l){
+    const Graph& fine = l == 0 ? g : levels[l-1];
+    const std::vector<int>& cmap = cmaps[l];
+    std::vector<int> fine_side(fine.numVertices());
+    for (int v=0; v < fine.numVertices(); ++v){
+      fine_side[v] = side[cmap[v]];
+    }
+    side.swap(fine_side);
+    refine(fine, side, frac, ubfactor);
+  }
+  return side;
+}
+
+GraphPartitioner::Graph
+GraphPartitioner::coarsen(const Graph& g, std::vector<int>& cmap)
+{
+  int n = g.numVertices();
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  for (int i=n-1; i > 0; --i){
+    std::swap(order[i], order[rng_() % (i+1)]);
+  }
+
+  //don't let a few huge vertices form, they can't be balanced later
+  int64_t max_vwgt = 3 * g.totalWeight() / (2 * coarsen_to_) + 1;
+  std::vector<int> match(n, -1);
+  cmap.assign(n, -1);
+  int nc = 0;
+  for (int v : order){
+    if (match[v] >= 0) continue;
+    int best = -1;
+    int64_t best_wgt = -1;
+    for (int e=g.xadj[v]; e < g.xadj[v+1]; ++e){
+      int u = g.adjncy[e];
+      if (match[u] < 0 && g.vwgt[v] + g.vwgt[u] <= max_vwgt && g.adjwgt[e] > best_wgt){
+        best = u;
+        best_wgt = g.adjwgt[e];
+      }
+    }
+    if (best >= 0){
+      match[v] = best;
+      match[best] = v;
+      cmap[v] = cmap[best] = nc++;
+    } else {
+      match[v] = v;
+      cmap[v] = nc++;
+    }
+  }
+
+  //collect the fine vertices of each coarse vertex
+  std::vector<int> first(nc+1, 0);
+  for (int v=0; v < n; ++v){
+    ++first[cmap[v]+1];
+  }
+  for (int c=0; c < nc; ++c){
+    first[c+1] += first[c];
+  }
+  std::vector<int> members(n);
+  std::vector<int> next(first.begin(), first.end()-1);
+  for (int v=0; v < n; ++v){
+    members[next[cmap[v]]++] = v;
+  }
+
+  Graph coarse;
+  coarse.vwgt.assign(nc, 0);
+  coarse.xadj.reserve(nc+1);
+  coarse.xadj.push_back(0);
+  std::vector<int> where(nc, -1);
+  for (int c=0; c < nc; ++c){
+    int row_start = coarse.adjncy.size();
+    for (int m=first[c]; m < first[c+1]; ++m){
+      int v = members[m];
+      coarse.vwgt[c] += g.vwgt[v];
+      for (int e=g.xadj[v]; e < g.xadj[v+1]; ++e){
+        int cu = cmap[g.adjncy[e]];
+        if (cu == c) continue;
+        if (where[cu] >= row_start){
+          coarse.adjwgt[where[cu]] += g.adjwgt[e];
+        } else {
+          where[cu] = coarse.adjncy.size();
+          coarse.adjncy.push_back(cu);
+          coarse.adjwgt.push_back(g.adjwgt[e]);
+        }
+      }
+    }
+    coarse.xadj.push_back(coarse.adjncy.size());
+  }
+  return coarse;
+}
+
+static double
+balanceExcess(const int64_t w[2], double max0, double max1)
+{
+  return std::max(0.0, w[0] - max0) + std::max(0.0, w[1] - max1);
+}
+
+std::vector<int>
+GraphPartitioner::growBisection(const Graph& g, double frac, double ubfactor)
+{
+  int n = g.numVertices();
+  int64_t total = g.totalWeight();
+  double target0 = frac * total;
+  double max0 = target0 * ubfactor;
+  double max1 = (total - target0) * ubfactor;
+
+  std::vector<int> best_side;
+  int64_t best_cut = std::numeric_limits<int64_t>::max();
+  double best_excess = std::numeric_limits<double>::max();
+  for (int t=0; t < num_grow_tries_; ++t){
+    //grow side 0 from a random vertex, always adding the vertex that cuts the fewest edges
+    std::vector<int> side(n, 1);
+    std::vector<int64_t> gain(n, 0);
+    std::vector<char> frontier(n, 0);
+    for (int v=0; v < n; ++v){
+      for (int e=g.xadj[v]; e < g.xadj[v+1]; ++e){
+        gain[v] -= g.adjwgt[e];
+      }
+    }
+    int64_t w0 = 0;
+    int next = rng_() % n;
+    while (w0 < target0){
+      if (next < 0){
+        for (int v=0; v < n; ++v){
+          if (frontier[v] && (next < 0 || gain[v] > gain[next])){
+            next = v;
+          }
+        }
+      }
+      if (next < 0){
+        //disconnected graph - jump to another component
+        for (int v=0; v < n && next < 0; ++v){
+          if (side[v] == 1) next = v;
+        }
+      }
+      if (next < 0) break;
+      side[next] = 0;
+      frontier[next] = 0;
+      w0 += g.vwgt[next];
+      for (int e=g.xadj[next]; e < g.xadj[next+1]; ++e){
+        int u = g.adjncy[e];
+        if (side[u] == 1){
+          gain[u] += 2*g.adjwgt[e];
+          frontier[u] = 1;
+        }
+      }
+      next = -1;
+    }
+
+    refine(g, side, frac, ubfactor);
+    int64_t w[2] = {0, 0};
+    for (int v=0; v < n; ++v){
+      w[side[v]] += g.vwgt[v];
+    }
+    double excess = balanceExcess(w, max0, max1);
+    int64_t cut = edgeCut(g, side);
+    if (excess < best_excess || (excess == best_excess && cut < best_cut)){
+      best_excess = excess;
+      best_cut = cut;
+      best_side.swap(side);
+    }
+  }
+  return best_side;
+}
+
+void
+GraphPartitioner::refine(const Graph& g, std::vector<int>& side, double frac, double ubfactor)
+{
+  int n = g.numVertices();
+  int64_t total = g.totalWeight();
+  double max0 = frac * total * ubfactor;
+  double max1 = (1.0 - frac) * total * ubfactor;
+
+  std::vector<int64_t> gain(n);
+  std::vector<char> locked(n);
+  std::vector<int> moves;
+  for (int pass=0; pass < num_refine_passes_; ++pass){
+    int64_t w[2] = {0, 0};
+    int64_t cut = 0;
+    std::set<std::pair<int64_t,int>> queue[2];
+    for (int v=0; v < n; ++v){
+      gain[v] = 0;
+      for (int e=g.xadj[v]; e < g.xadj[v+1]; ++e){
+        int64_t wgt = g.adjwgt[e];
+        gain[v] += side[g.adjncy[e]] == side[v] ? -wgt : wgt;
+        if (side[g.adjncy[e]] != side[v]) cut += wgt;
+      }
+      w[side[v]] += g.vwgt[v];
+      queue[side[v]].emplace(gain[v], v);
+    }
+    cut /= 2;
+
+    std::fill(locked.begin(), locked.end(), 0);
+    moves.clear();
+    int64_t best_cut = cut;
+    double best_excess = balanceExcess(w, max0, max1);
+    int best_num_moves = 0;
+    int num_bad_moves = 0;
+    while (num_bad_moves < max_bad_moves_){
+      int from = -1;
+      if (w[0] > max0){
+        from = 0;
+      } else if (w[1] > max1){
+        from = 1;
+      } else {
+        //take the best move that keeps both sides in balance
+        int64_t best_gain = 0;
+        for (int s=0; s < 2; ++s){
+          if (queue[s].empty()) continue;
+          auto& top = *queue[s].rbegin();
+          double dst_max = s == 0 ? max1 : max0;
+          if (w[1-s] + g.vwgt[top.second] > dst_max) continue;
+          if (from < 0 || top.first > best_gain){
+            from = s;
+            best_gain = top.first;
+          }
+        }
+      }
+      if (from < 0 || queue[from].empty()) break;
+
+      auto it = std::prev(queue[from].end());
+      int v = it->second;
+      queue[from].erase(it);
+      locked[v] = 1;
+      cut -= gain[v];
+      side[v] = 1 - from;
+      w[from] -= g.vwgt[v];
+      w[1-from] += g.vwgt[v];
+      moves.push_back(v);
+      for (int e=g.xadj[v]; e < g.xadj[v+1]; ++e){
+        int u = g.adjncy[e];
+        int64_t delta = side[u] == from ? 2*g.adjwgt[e] : -2*g.adjwgt[e];
+        if (locked[u]){
+          gain[u] += delta;
+        } else {
+          queue[side[u]].erase(std::make_pair(gain[u], u));
+          gain[u] += delta;
+          queue[side[u]].emplace(gain[u], u);
+        }
+      }
+      gain[v] = -gain[v];
+
+      double excess = balanceExcess(w, max0, max1);
+      if (excess < best_excess || (excess == best_excess && cut < best_cut)){
+        best_excess = excess;
+        best_cut = cut;
+        best_num_moves = moves.size();
+        num_bad_moves = 0;
+      } else {
+        ++num_bad_moves;
+      }
+    }
+
+    //undo everything after the best point in the pass
+    for (int i=int(moves.size())-1; i >= best_num_moves; --i){
+      side[moves[i]] = 1 - side[moves[i]];
+    }
+    if (best_num_moves == 0) break;
+  }
+}
+
+GraphPartitioner::Graph
+GraphPartitioner::subgraph(const Graph& g, const std::vector<int>& side, int which,
+                           std::vector<int>& ids)
+{
+  int n = g.numVertices();
+  std::vector<int> local(n, -1);
+  ids.clear();
+  for (int v=0; v < n; ++v){
+    if (side[v] == which){
+      local[v] = ids.size();
+      ids.push_back(v);
+    }
+  }
+
+  Graph sub;
+  sub.xadj.reserve(ids.size()+1);
+  sub.xadj.push_back(0);
+  for (int v : ids){
+    sub.vwgt.push_back(g.vwgt[v]);
+    for (int e=g.xadj[v]; e < g.xadj[v+1]; ++e){
+      int u = local[g.adjncy[e]];
+      if (u >= 0){
+        sub.adjncy.push_back(u);
+        sub.adjwgt.push_back(g.adjwgt[e]);
+      }
+    }
+    sub.xadj.push_back(sub.adjncy.size());
+  }
+  return sub;
+}
+
+int64_t
+GraphPartitioner::edgeCut(const Graph& g, const std::vector<int>& part)
+{
+  int64_t cut = 0;
+  for (int v=0; v < g.numVertices(); ++v){
+    for (int e=g.xadj[v]; e < g.xadj[v+1]; ++e){
+      if (part[g.adjncy[e]] != part[v]){
+        cut += g.adjwgt[e];
+      }
+    }
+  }
+  return cut / 2;
+}
+
+double
+GraphPartitioner::imbalance(const Graph& g, const std::vector<int>& part, int nparts)
+{
+  std::vector<int64_t> weights(nparts, 0);
+  for (int v=0; v < g.numVertices(); ++v){
+    weights[part[v]] += g.vwgt[v];
+  }
+  int64_t total = g.totalWeight();
+  if (total == 0) return 1.0;
+  int64_t max_weight = *std::max_element(weights.begin(), weights.end());
+  return double(max_weight) * nparts / total;
+}
+
+}
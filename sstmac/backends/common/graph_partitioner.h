@@ -0,0 +1,139 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+
+#ifndef SSTMAC_BACKENDS_COMMON_GRAPH_PARTITIONER_H_INCLUDED
+#define SSTMAC_BACKENDS_COMMON_GRAPH_PARTITIONER_H_INCLUDED
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace sstmac {
+
+/**
+ * A multilevel graph partitioner in the style of METIS.
+ * Each bisection coarsens the graph by heavy-edge matching, splits the coarsest graph
+ * by greedy graph growing, and refines the split with Fiduccia-Mattheyses passes
+ * while projecting back to the original graph. More than two parts are built by
+ * recursive bisection. The result depends only on the graph and the seed,
+ * so every rank computes the same partition.
+ */
+class GraphPartitioner
+{
+ public:
+  /** An undirected graph in compressed sparse row format */
+  struct Graph {
+    std::vector<int> xadj;
+    std::vector<int> adjncy;
+    std::vector<int64_t> adjwgt;
+    std::vector<int64_t> vwgt;
+
+    int numVertices() const {
+      return vwgt.size();
+    }
+
+    int64_t totalWeight() const;
+
+    /**
+     * @brief build Make a graph from a list of edges
+     * @param vwgt  The weight of each vertex
+     * @param edges The weight of each edge, keyed by (smaller,larger) vertex.
+     *              Both directions of an edge are added.
+     */
+    static Graph build(const std::vector<int64_t>& vwgt,
+                       const std::map<std::pair<int,int>,int64_t>& edges);
+  };
+
+  /**
+   * @param max_imbalance The allowed ratio of the heaviest part to the average part, minus one
+   * @param seed For the random visit order of matching and the start vertices of graph growing
+   */
+  GraphPartitioner(double max_imbalance, uint32_t seed = 42);
+
+  /**
+   * @brief partition
+   * @param g The graph to partition
+   * @param nparts The number of parts
+   * @return The part of each vertex
+   */
+  std::vector<int> partition(const Graph& g, int nparts);
+
+  static int64_t edgeCut(const Graph& g, const std::vector<int>& part);
+
+  /**
+   * @return The weight of the heaviest part divided by the average part weight
+   */
+  static double imbalance(const Graph& g, const std::vector<int>& part, int nparts);
+
+ private:
+  void recursiveBisect(const Graph& g, const std::vector<int>& ids,
+                       int nparts, int first_part, double ubfactor,
+                       std::vector<int>& part);
+
+  std::vector<int> bisect(const Graph& g, double frac, double ubfactor);
+
+  Graph coarsen(const Graph& g, std::vector<int>& cmap);
+
+  std::vector<int> growBisection(const Graph& g, double frac, double ubfactor);
+
+  void refine(const Graph& g, std::vector<int>& side, double frac, double ubfactor);
+
+  static Graph subgraph(const Graph& g, const std::vector<int>& side, int which,
+                        std::vector<int>& ids);
+
+  double max_imbalance_;
+  std::mt19937 rng_;
+
+  static constexpr int coarsen_to_ = 40;
+  static constexpr int num_grow_tries_ = 4;
+  static constexpr int num_refine_passes_ = 8;
+  static constexpr int max_bad_moves_ = 64;
+
+};
+
+}
+
+#endif
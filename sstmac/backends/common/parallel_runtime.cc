@@ -66,6 +66,7 @@ RegisterKeywords(
 { "partition", "the partitioning algorithm for assigning work to logical processes" },
 { "runtime", "the underlying runtime (usually MPI or serial) managing logical processes" },
 { "sst_nthread", "the number of threads to use" },
+{ "sst_thread_work_units", "the number of migratable work units spread over the threads" },
 { "sst_nproc", "the number of parallel procs (ranks) to use" }
 );
 
@@ -165,6 +166,23 @@ ParallelRuntime::CommBuffer::realloc(size_t size)
   if (oldAlloc) delete[] oldAlloc;
 }
 
+void
+ParallelRuntime::CommBuffer::reserve(size_t size)
+{
+  if (allocSize >= int64_t(size)) return;
+
+  char* oldAlloc = allocation;
+  char* oldStorage = storage;
+  allocSize = std::max(int64_t(size), 2*allocSize);
+  allocation = new char[allocSize+64];
+  storage = allocation;
+  align64(storage);
+  if (oldAlloc){
+    ::memcpy(storage, oldStorage, bytesAllocated);
+    delete[] oldAlloc;
+  }
+}
+
 void
 ParallelRuntime::bcastString(std::string& str, int root)
 {
@@ -265,7 +283,13 @@ ParallelRuntime::initRuntimeParams(SST::Params& params)
   sends_done_.resize(nproc_);
 
   //turn the number of procs and my rank into keywords
-  nthread_ = params.find<int>("sst_nthread", 1);
+  nworker_ = params.find<int>("sst_nthread", 1);
+  //everything that is partitioned by thread is partitioned by work unit
+  nthread_ = params.find<int>("sst_thread_work_units", nworker_);
+  if (nthread_ < nworker_){
+    spkt_abort_printf("sst_thread_work_units=%d must be at least sst_nthread=%d",
+                      nthread_, nworker_);
+  }
 
   buf_size_ = params.find<SST::UnitAlgebra>("serialization_buffer_size", "16KB").getRoundedValue();
 
@@ -289,8 +313,10 @@ ParallelRuntime::ParallelRuntime(SST::Params&  /*params*/,
                                    int me, int nproc)
   : nproc_(nproc),
     nthread_(1),
+    nworker_(1),
     me_(me),
     epoch_(0),
+    eager_bytes_(0),
     part_(nullptr)
 {
   if (me_ == 0){
@@ -358,9 +384,62 @@ void ParallelRuntime::sendEvent(IpcEvent* iev)
   iev->ev->validate_serialization(test_ev.ev);
 #endif
 
+  //MPI calls only come from the main thread, so worker threads leave everything for the end of the epoch
+  if (eager_bytes_ && nworker_ == 1 && buff.totalBytes() >= eager_bytes_){
+    sendEager(iev->rank);
+  }
+
 }
 #endif
 
+void
+ParallelRuntime::sendRecvNeighbors(const std::vector<int>& send_to,
+                                   const std::vector<Timestamp>&  /*promises*/,
+                                   const std::vector<int>& recv_from,
+                                   std::vector<Timestamp>&  /*clocks*/)
+{
+  if (!send_to.empty() || !recv_from.empty()){
+    spkt_abort_printf("parallel runtime does not support point-to-point neighbor exchange");
+  }
+}
+
+void
+ParallelRuntime::initOverlap(const std::vector<int>& send_to,
+                             const std::vector<int>& recv_from,
+                             size_t eager_bytes)
+{
+  overlap_send_to_ = send_to;
+  overlap_recv_from_ = recv_from;
+  eager_bytes_ = eager_bytes;
+}
+
+void
+ParallelRuntime::sendRecvOverlapped()
+{
+  if (!overlap_send_to_.empty() || !overlap_recv_from_.empty()){
+    spkt_abort_printf("parallel runtime does not support overlapped epochs");
+  }
+}
+
+void
+ParallelRuntime::sendEager(int  /*dst*/)
+{
+  spkt_abort_printf("parallel runtime does not support eager sends");
+}
+
+void
+ParallelRuntime::startVote(Timestamp  /*vote*/)
+{
+  spkt_abort_printf("parallel runtime does not support nonblocking votes");
+}
+
+Timestamp
+ParallelRuntime::finishVote()
+{
+  spkt_abort_printf("parallel runtime does not support nonblocking votes");
+  return Timestamp();
+}
+
 void
 ParallelRuntime::resetSendRecv()
 {
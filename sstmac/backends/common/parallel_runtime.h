@@ -154,6 +154,12 @@ class ParallelRuntime :
       }
     }
 
+    /**
+     * @brief reserve Grow the storage to at least size bytes,
+     *        keeping the bytes already in the buffer
+     */
+    void reserve(size_t size);
+
     void shift(size_t size){
       bytesAllocated += size;
     }
@@ -232,6 +238,52 @@ class ParallelRuntime :
     return vote;
   }
 
+  /**
+   * @brief sendRecvNeighbors Exchange pending events and channel clocks with neighboring LPs only.
+   *        Every LP in send_to must have this LP in its recv_from list and vice versa.
+   *        Received events are placed in the receive buffers, the same as sendRecvMessages.
+   * @param send_to   The LPs this LP has links to
+   * @param promises  For each LP in send_to, a lower bound on the time of any event sent to it
+   *                  after this exchange
+   * @param recv_from The LPs that have links to this LP
+   * @param clocks    Filled in with the promise from each LP in recv_from
+   */
+  virtual void sendRecvNeighbors(const std::vector<int>& send_to,
+                                 const std::vector<Timestamp>& promises,
+                                 const std::vector<int>& recv_from,
+                                 std::vector<Timestamp>& clocks);
+
+  /**
+   * @brief initOverlap Set up overlapped epochs, where events for a neighboring LP are sent
+   *        as soon as eager_bytes of them are pending instead of at the end of the epoch.
+   *        Must be called by all LPs. The neighbor lists follow the same rules as sendRecvNeighbors.
+   * @param send_to     The LPs this LP has links to
+   * @param recv_from   The LPs that have links to this LP
+   * @param eager_bytes The number of pending bytes that triggers an early send, zero for never
+   */
+  virtual void initOverlap(const std::vector<int>& send_to,
+                           const std::vector<int>& recv_from,
+                           size_t eager_bytes);
+
+  /**
+   * @brief sendRecvOverlapped Finish the event exchange for an overlapped epoch.
+   *        Sends whatever is still pending to each neighbor and receives everything neighbors
+   *        sent during the epoch. Received events are placed in the receive buffers.
+   */
+  virtual void sendRecvOverlapped();
+
+  /**
+   * @brief startVote Begin a nonblocking global minimum over the time votes
+   * @param vote The minimum event time I have
+   */
+  virtual void startVote(Timestamp vote);
+
+  /**
+   * @brief finishVote Complete the vote begun by the last startVote
+   * @return The minimum time across all LPs, zero if no vote is in flight
+   */
+  virtual Timestamp finishVote();
+
   void resetSendRecv();
 
   int me() const {
@@ -242,10 +294,23 @@ class ParallelRuntime :
     return nproc_;
   }
 
+  /**
+   * @brief nthread
+   * @return The number of thread work units, each with its own event manager.
+   *         Equal to the number of worker threads unless sst_thread_work_units is set.
+   */
   int nthread() const {
     return nthread_;
   }
 
+  /**
+   * @brief nworker
+   * @return The number of OS threads that the thread work units run on
+   */
+  int nworker() const {
+    return nworker_;
+  }
+
   int ser_buf_size() const {
     return buf_size_;
   }
@@ -273,9 +338,16 @@ class ParallelRuntime :
   ParallelRuntime(SST::Params& params,
                    int me, int nproc);
 
+  /**
+   * @brief sendEager Start sending everything pending for an LP in the middle of an epoch
+   * @param dst The LP to send to
+   */
+  virtual void sendEager(int dst);
+
  protected:
    int nproc_;
    int nthread_;
+   int nworker_;
    int me_;
    int epoch_;
    std::vector<CommBuffer> send_buffers_;
@@ -284,6 +356,9 @@ class ParallelRuntime :
    int num_sends_done_;
    int numRecvsDone_;
    int buf_size_;
+   size_t eager_bytes_;
+   std::vector<int> overlap_send_to_;
+   std::vector<int> overlap_recv_from_;
    Partition* part_;
    static ParallelRuntime* static_runtime_;
 
@@ -44,6 +44,7 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <sstmac/backends/common/sim_partition.h>
 #include <sstmac/backends/common/parallel_runtime.h>
+#include <sstmac/backends/common/graph_partitioner.h>
 #include <sstmac/hardware/topology/topology.h>
 #include <sstmac/hardware/interconnect/interconnect.h>
 
@@ -51,11 +52,20 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <sprockit/util.h>
 #include <sprockit/basic_string_tokenizer.h>
 #include <sprockit/errors.h>
+#include <sprockit/output.h>
+#include <sprockit/keyword_registration.h>
 
+#include <cinttypes>
 #include <cstring>
+#include <sstream>
 
 RegisterDebugSlot(partition);
 
+RegisterKeywords(
+{ "partition_imbalance", "for graph partitions, the allowed load above the average partition, e.g. 0.05" },
+{ "partition_traffic_file", "for graph partitions, a bytes_sent statistics file to weight switches and links by" },
+);
+
 #define part_debug(...) \
   debug_printf(sprockit::dbg::partition, "Rank %d: %s", me_, sprockit::sprintf(__VA_ARGS__).c_str())
 
@@ -168,6 +178,98 @@ BlockPartition::finalizeInit(SST::Params&  /*params*/)
   partitionSwitches();
 }
 
+GraphPartition::GraphPartition(SST::Params& params, ParallelRuntime* rt)
+  : BlockPartition(params, rt)
+{
+  max_imbalance_ = params.find<double>("partition_imbalance", 0.05);
+  traffic_file_ = params.find<std::string>("partition_traffic_file", "");
+}
+
+GraphPartition::~GraphPartition()
+{
+}
+
+void
+GraphPartition::readTraffic(std::map<std::pair<int,int>,int64_t>& port_bytes)
+{
+  //every rank must take part in the broadcast
+  std::istream* in = rt_->bcastFileStream(traffic_file_);
+  std::string line;
+  int sw = -1;
+  while (std::getline(*in, line)){
+    std::stringstream sstr(line);
+    std::string first;
+    if (!(sstr >> first)) continue;
+    if (first == "Switch"){
+      sstr >> sw;
+    } else if (sw >= 0){
+      int port = std::stoi(first);
+      int64_t bytes;
+      if (sstr >> bytes){
+        port_bytes[std::make_pair(sw, port)] += bytes;
+      }
+    }
+  }
+  delete in;
+}
+
+void
+GraphPartition::partitionSwitches()
+{
+  std::map<std::pair<int,int>,int64_t> port_bytes;
+  bool use_traffic = !traffic_file_.empty();
+  if (use_traffic){
+    readTraffic(port_bytes);
+  }
+
+  std::vector<int64_t> vwgt(num_switches_total_);
+  std::map<std::pair<int,int>,int64_t> edges;
+  std::vector<hw::Topology::Connection> conns;
+  std::vector<hw::Topology::InjectionPort> nodes;
+  for (int sw=0; sw < num_switches_total_; ++sw){
+    if (use_traffic){
+      //the busier the switch, the more events it runs
+      vwgt[sw] = 1;
+      auto end = port_bytes.lower_bound(std::make_pair(sw+1, 0));
+      for (auto it = port_bytes.lower_bound(std::make_pair(sw, 0)); it != end; ++it){
+        vwgt[sw] += it->second;
+      }
+    } else {
+      fake_top_->endpointsConnectedToInjectionSwitch(sw, nodes);
+      vwgt[sw] = 1 + nodes.size();
+    }
+
+    fake_top_->connectedOutports(sw, conns);
+    for (auto& conn : conns){
+      int64_t weight = 1;
+      if (use_traffic){
+        auto iter = port_bytes.find(std::make_pair(sw, conn.src_outport));
+        if (iter != port_bytes.end()) weight += iter->second;
+      }
+      edges[std::make_pair(std::min(sw, int(conn.dst)), std::max(sw, int(conn.dst)))] += weight;
+    }
+  }
+
+  auto graph = GraphPartitioner::Graph::build(vwgt, edges);
+  int nparts = nproc_ * nthread_;
+  GraphPartitioner partitioner(max_imbalance_);
+  std::vector<int> parts = partitioner.partition(graph, nparts);
+  for (int sw=0; sw < num_switches_total_; ++sw){
+    switch_to_lpid_[sw] = parts[sw] / nthread_;
+    switch_to_thread_[sw] = parts[sw] % nthread_;
+  }
+
+  int64_t total_cut = 0;
+  for (auto& pair : edges){
+    if (pair.first.first != pair.first.second) total_cut += pair.second;
+  }
+  cout0 << sprockit::sprintf("Graph partition of %d switches into %d parts cuts %" PRId64 " of %" PRId64
+                             " link weight with load imbalance %5.3f\n",
+                             num_switches_total_, nparts,
+                             GraphPartitioner::edgeCut(graph, parts), total_cut,
+                             GraphPartitioner::imbalance(graph, parts, nparts));
+}
+
 OccupiedBlockPartition::OccupiedBlockPartition(SST::Params& params,
                                                    ParallelRuntime* rt)
   : BlockPartition(params, rt)
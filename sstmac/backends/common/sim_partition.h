@@ -55,6 +55,7 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <sstmac/sst_core/integrated_component.h>
 
+#include <map>
 #include <vector>
 
 DeclareDebugSlot(partition);
@@ -188,6 +189,42 @@ class BlockPartition :
 
 };
 
+/**
+ * Balanced min-cut partition of the switch graph. Each switch is weighted by
+ * the nodes attached to it and each link by one, or both by the bytes sent on
+ * each port in a bytes_sent statistics file from a previous run.
+ */
+class GraphPartition :
+  public BlockPartition
+{
+ public:
+  SST_ELI_REGISTER_DERIVED(
+    Partition,
+    GraphPartition,
+    "macro",
+    "graph",
+    SST_ELI_ELEMENT_VERSION(1,0,0),
+    "partition minimizing cut links with a multilevel graph partitioner")
+
+  GraphPartition(SST::Params& params, ParallelRuntime* rt);
+
+  ~GraphPartition() override;
+
+  void partitionSwitches() override;
+
+ protected:
+  /**
+   * @brief readTraffic Parse the output of the bytes_sent statistic
+   * @param port_bytes Filled in with the bytes sent on each (switch,port)
+   */
+  void readTraffic(std::map<std::pair<int,int>,int64_t>& port_bytes);
+
+  double max_imbalance_;
+
+  std::string traffic_file_;
+
+};
+
 class OccupiedBlockPartition :
   public BlockPartition
 {
@@ -189,7 +189,11 @@ MpiRuntime::initRuntimeParams(SST::Params& params)
 MpiRuntime::MpiRuntime(SST::Params& params) :
   ParallelRuntime(params,
   initRank(params),
-  initSize(params))
+  initSize(params)),
+  overlap_comm_(MPI_COMM_NULL),
+  vote_send_(0),
+  vote_recv_(0),
+  vote_pending_(false)
 {
   epoch_ = 0;
   int rc = MPI_Op_create(&voteReduceFunction, 1, &vote_op_);
@@ -317,6 +321,185 @@ MpiRuntime::sendRecvMessages(Timestamp vote)
   return Timestamp(0, incoming.time_vote);
 }
 
+void
+MpiRuntime::sendRecvNeighbors(const std::vector<int>& send_to,
+                              const std::vector<Timestamp>& promises,
+                              const std::vector<int>& recv_from,
+                              std::vector<Timestamp>& clocks)
+{
+  static const int header_tag = 44;
+  static const int payload_tag = 45;
+
+  //first exchange the channel clocks and the number of bytes to expect
+  send_headers_.resize(send_to.size());
+  recv_headers_.resize(recv_from.size());
+  int reqIdx = 0;
+  for (int i=0; i < send_to.size(); ++i){
+    int dst = send_to[i];
+    send_headers_[i].promise = promises[i].time.ticks();
+    send_headers_[i].num_bytes = send_buffers_[dst].totalBytes();
+    MPI_Isend(&send_headers_[i], sizeof(neighbor_header), MPI_BYTE, dst,
+              header_tag, MPI_COMM_WORLD, &requests_[reqIdx++]);
+  }
+  for (int i=0; i < recv_from.size(); ++i){
+    MPI_Irecv(&recv_headers_[i], sizeof(neighbor_header), MPI_BYTE, recv_from[i],
+              header_tag, MPI_COMM_WORLD, &requests_[reqIdx++]);
+  }
+  MPI_Waitall(reqIdx, requests_.data(), MPI_STATUSES_IGNORE);
+
+  //then exchange the events themselves, only with neighbors that have any
+  reqIdx = 0;
+  for (int i=0; i < send_to.size(); ++i){
+    int dst = send_to[i];
+    CommBuffer& comm = send_buffers_[dst];
+    int commSize = comm.totalBytes();
+    if (commSize){
+      char* buffer = comm.buffer();
+      if (comm.hasBackup()){
+        buffer = comm.backup();
+        comm.copyToBackup();
+      }
+      mpi_debug("sending %d bytes to neighbor LP %d on epoch %d", commSize, dst, epoch_);
+      MPI_Isend(buffer, commSize, MPI_BYTE, dst,
+                payload_tag, MPI_COMM_WORLD, &requests_[reqIdx++]);
+      sends_done_[num_sends_done_++] = dst;
+    }
+  }
+  int firstRecv = numRecvsDone_;
+  for (int i=0; i < recv_from.size(); ++i){
+    clocks[i] = Timestamp(0, recv_headers_[i].promise);
+    uint64_t numBytes = recv_headers_[i].num_bytes;
+    if (numBytes){
+      CommBuffer& comm = recv_buffers_[numRecvsDone_++];
+      comm.ensureSpace(numBytes);
+      mpi_debug("receiving %lu bytes from neighbor LP %d on epoch %d", numBytes, recv_from[i], epoch_);
+      MPI_Irecv(comm.buffer(), numBytes, MPI_BYTE, recv_from[i],
+                payload_tag, MPI_COMM_WORLD, &requests_[reqIdx++]);
+    }
+  }
+  MPI_Waitall(reqIdx, requests_.data(), MPI_STATUSES_IGNORE);
+
+  int recvIdx = firstRecv;
+  for (int i=0; i < recv_from.size(); ++i){
+    uint64_t numBytes = recv_headers_[i].num_bytes;
+    if (numBytes){
+      recv_buffers_[recvIdx++].shift(numBytes);
+    }
+  }
+  ++epoch_;
+}
+
+void
+MpiRuntime::initOverlap(const std::vector<int>& send_to,
+                        const std::vector<int>& recv_from,
+                        size_t eager_bytes)
+{
+  ParallelRuntime::initOverlap(send_to, recv_from, eager_bytes);
+  if (overlap_comm_ == MPI_COMM_NULL){
+    MPI_Comm_dup(MPI_COMM_WORLD, &overlap_comm_);
+  }
+}
+
+static const int overlap_partial_tag = 0;
+static const int overlap_final_tag = 1;
+
+void
+MpiRuntime::sendEager(int dst)
+{
+  CommBuffer& comm = send_buffers_[dst];
+  int commSize = comm.totalBytes();
+  if (commSize == 0) return;
+
+  char* buffer = comm.buffer();
+  if (comm.hasBackup()){
+    buffer = comm.backup();
+    comm.copyToBackup();
+  }
+  //the send buffer keeps filling while this is in flight - give it its own copy
+  char* chunk = new char[commSize];
+  ::memcpy(chunk, buffer, commSize);
+  eager_buffers_.push_back(chunk);
+  eager_requests_.emplace_back();
+  mpi_debug("eagerly sending %d bytes to neighbor LP %d on epoch %d", commSize, dst, epoch_);
+  MPI_Isend(chunk, commSize, MPI_BYTE, dst, overlap_partial_tag,
+            overlap_comm_, &eager_requests_.back());
+  comm.reset();
+}
+
+void
+MpiRuntime::sendRecvOverlapped()
+{
+  //every neighbor gets a final chunk, even an empty one, so receivers know the epoch is done
+  int reqIdx = 0;
+  for (int dst : overlap_send_to_){
+    CommBuffer& comm = send_buffers_[dst];
+    int commSize = comm.totalBytes();
+    char* buffer = comm.buffer();
+    if (comm.hasBackup()){
+      buffer = comm.backup();
+      comm.copyToBackup();
+    }
+    if (commSize){
+      sends_done_[num_sends_done_++] = dst;
+    }
+    mpi_debug("sending final %d bytes to neighbor LP %d on epoch %d", commSize, dst, epoch_);
+    MPI_Isend(buffer, commSize, MPI_BYTE, dst, overlap_final_tag,
+              overlap_comm_, &requests_[reqIdx++]);
+  }
+
+  //messages from one LP cannot overtake each other, so the final chunk is the last for this epoch
+  for (int src : overlap_recv_from_){
+    CommBuffer& comm = recv_buffers_[numRecvsDone_++];
+    int tag = overlap_partial_tag;
+    while (tag != overlap_final_tag){
+      MPI_Status stat;
+      MPI_Probe(src, MPI_ANY_TAG, overlap_comm_, &stat);
+      int numBytes;
+      MPI_Get_count(&stat, MPI_BYTE, &numBytes);
+      comm.reserve(comm.totalBytes() + numBytes);
+      MPI_Recv(comm.nextBuffer(), numBytes, MPI_BYTE, src, stat.MPI_TAG,
+               overlap_comm_, MPI_STATUS_IGNORE);
+      comm.shift(numBytes);
+      tag = stat.MPI_TAG;
+    }
+    mpi_debug("received %lu bytes from neighbor LP %d on epoch %d", comm.totalBytes(), src, epoch_);
+  }
+
+  MPI_Waitall(reqIdx, requests_.data(), MPI_STATUSES_IGNORE);
+  if (!eager_requests_.empty()){
+    MPI_Waitall(eager_requests_.size(), eager_requests_.data(), MPI_STATUSES_IGNORE);
+    for (char* chunk : eager_buffers_){
+      delete[] chunk;
+    }
+    eager_requests_.clear();
+    eager_buffers_.clear();
+  }
+  ++epoch_;
+}
+
+void
+MpiRuntime::startVote(Timestamp vote)
+{
+  if (vote_pending_){
+    spkt_abort_printf("MpiRuntime::startVote: previous vote has not finished");
+  }
+  vote_send_ = vote.time.ticks();
+  MPI_Iallreduce(&vote_send_, &vote_recv_, 1, MPI_UINT64_T, MPI_MIN,
+                 overlap_comm_, &vote_request_);
+  vote_pending_ = true;
+}
+
+Timestamp
+MpiRuntime::finishVote()
+{
+  if (!vote_pending_){
+    return Timestamp();
+  }
+  MPI_Wait(&vote_request_, MPI_STATUS_IGNORE);
+  vote_pending_ = false;
+  return Timestamp(0, vote_recv_);
+}
+
 void
 MpiRuntime::send(int dst, void *buffer, int buffer_size)
 {
@@ -347,6 +530,9 @@ void
 MpiRuntime::finalize()
 {
   MPI_Barrier(MPI_COMM_WORLD);
+  if (overlap_comm_ != MPI_COMM_NULL){
+    MPI_Comm_free(&overlap_comm_);
+  }
   MPI_Finalize();
 }
 
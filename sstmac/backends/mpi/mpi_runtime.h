@@ -99,7 +99,24 @@ class MpiRuntime :
 
   Timestamp sendRecvMessages(Timestamp vote) override;
 
+  void sendRecvNeighbors(const std::vector<int>& send_to,
+                         const std::vector<Timestamp>& promises,
+                         const std::vector<int>& recv_from,
+                         std::vector<Timestamp>& clocks) override;
+
+  void initOverlap(const std::vector<int>& send_to,
+                   const std::vector<int>& recv_from,
+                   size_t eager_bytes) override;
+
+  void sendRecvOverlapped() override;
+
+  void startVote(Timestamp vote) override;
+
+  Timestamp finishVote() override;
+
  protected:
+  void sendEager(int dst) override;
+
   void doReduce(void* data, int nelems, MPI_Datatype ty, MPI_Op op, int root);
 
   void finalize() override;
@@ -119,6 +136,23 @@ class MpiRuntime :
   std::vector<MPI_Status> statuses_;
   std::vector<send_recv_vote> votes_;
 
+  struct neighbor_header {
+    uint64_t promise;
+    uint64_t num_bytes;
+  };
+
+  std::vector<neighbor_header> send_headers_;
+  std::vector<neighbor_header> recv_headers_;
+
+  /** Separate communicator so epoch chunks cannot match any other traffic */
+  MPI_Comm overlap_comm_;
+  std::vector<MPI_Request> eager_requests_;
+  std::vector<char*> eager_buffers_;
+  uint64_t vote_send_;
+  uint64_t vote_recv_;
+  MPI_Request vote_request_;
+  bool vote_pending_;
+
   MPI_Datatype vote_type_;
   MPI_Op vote_op_;
 
@@ -55,6 +55,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <sprockit/util.h>
 #include <sprockit/keyword_registration.h>
 #include <limits>
+#include <set>
 #include <cinttypes>
 
 #define event_debug(...) \
@@ -65,7 +66,12 @@ RegisterDebugSlot(EventManager_time_vote);
 
 RegisterKeywords(
   { "num_profile_loops", "the number of loops to execute of the parallel core for profiling parallel overheads" },
-  { "epoch_print_interval", "the print interval for stats on parallel execution" }
+  { "epoch_print_interval", "the print interval for stats on parallel execution" },
+  { "lookahead_mode", "global (default) or partition - whether each LP computes its horizon from "
+                      "the global minimum link latency or only the latencies of remote links into it" },
+  { "epoch_overlap", "whether to exchange events with neighboring LPs during an epoch and "
+                     "overlap the global time vote with the next epoch" },
+  { "ipc_eager_bytes", "with epoch_overlap, the number of pending bytes for an LP that triggers sending them early" },
 );
 
 #define epoch_debug(...) \
@@ -90,6 +96,81 @@ ClockCycleEventMap::ClockCycleEventMap(
 {
   num_profile_loops_ = params.find<int>("num_profile_loops", 0);
   epoch_print_interval = params.find<int>("epoch_print_interval", epoch_print_interval);
+  std::string mode = params.find<std::string>("lookahead_mode", "global");
+  if (mode == "global"){
+    partition_lookahead_ = false;
+  } else if (mode == "partition"){
+    partition_lookahead_ = true;
+  } else {
+    spkt_abort_printf("invalid lookahead_mode %s: must be global or partition", mode.c_str());
+  }
+  overlap_epochs_ = params.find<bool>("epoch_overlap", false);
+  eager_bytes_ = params.find<SST::UnitAlgebra>("ipc_eager_bytes", "64KB").getRoundedValue();
+}
+
+void
+ClockCycleEventMap::initOverlap()
+{
+  if (!overlap_epochs_ || nproc_ == 1) return;
+
+  std::set<int> send_to;
+  std::set<int> recv_from;
+  for (int t=0; t < nthread(); ++t){
+    EventManager* mgr = threadManager(t);
+    for (auto& pair : mgr->outgoingLatencies()){
+      send_to.insert(pair.first);
+    }
+    for (auto& pair : mgr->incomingLatencies()){
+      recv_from.insert(pair.first);
+    }
+  }
+  rt_->initOverlap(std::vector<int>(send_to.begin(), send_to.end()),
+                   std::vector<int>(recv_from.begin(), recv_from.end()),
+                   eager_bytes_);
+}
+
+Timestamp
+ClockCycleEventMap::nextLowerBound(Timestamp lower_bound, Timestamp vote)
+{
+  if (!overlap_epochs_ || nproc_ == 1){
+    return receiveIncomingEvents(vote);
+  }
+
+  rt_->sendRecvOverlapped();
+  scheduleIncomingBuffers();
+
+  //everything sent last epoch has been received, so no LP can have an event
+  //earlier than the vote from last epoch or the global horizon of this epoch
+  Timestamp last_vote = rt_->finishVote();
+  if (last_vote == no_events_left_time){
+    return no_events_left_time;
+  }
+  rt_->startVote(vote);
+  event_debug("started vote for %10.6e, last vote was %10.6e", vote.sec(), last_vote.sec());
+  return std::max(lower_bound + lookahead_, last_vote);
+}
+
+TimeDelta
+ClockCycleEventMap::computeLookahead()
+{
+  if (!partition_lookahead_){
+    return lookahead_;
+  }
+
+  //every event arriving from another LP was sent at or after the global lower bound,
+  //so nothing can arrive here earlier than the bound plus my shortest incoming link
+  TimeDelta lookahead;
+  for (int t=0; t < nthread(); ++t){
+    TimeDelta incoming = threadManager(t)->minIncomingLatency();
+    if (incoming.ticks() > 0 && (lookahead.ticks() == 0 || incoming < lookahead)){
+      lookahead = incoming;
+    }
+  }
+  if (lookahead < lookahead_){
+    //no remote links into this LP or something went wrong - fall back to the global value
+    lookahead = lookahead_;
+  }
+  return lookahead;
 }
 
 int
@@ -128,6 +209,13 @@ ClockCycleEventMap::receiveIncomingEvents(Timestamp vote)
 
   event_debug("got back minimum time %10.6e", min_time.sec());
 
+  scheduleIncomingBuffers();
+  return min_time;
+}
+
+void
+ClockCycleEventMap::scheduleIncomingBuffers()
+{
   int num_recvs = rt_->numRecvsDone();
   for (int i=0; i < num_recvs; ++i){
     auto& buf = rt_->recvBuffer(i);
@@ -140,7 +228,6 @@ ClockCycleEventMap::receiveIncomingEvents(Timestamp vote)
     }
   }
   rt_->resetSendRecv();
-  return min_time;
 }
 
 
@@ -148,6 +235,7 @@ void
 ClockCycleEventMap::run()
 {
   interconn_->setup();
+  initOverlap();
 
   Timestamp lower_bound;
   /** If we want to just execute the synchronization without any actual events
@@ -162,19 +250,31 @@ ClockCycleEventMap::run()
   if (lookahead_.ticks() == 0){
     sprockit::abort("Zero-latency link - no lookahaed, cannot run in parallel");
   }
-  if (rt_->me() == 0){
-    printf("Running parallel simulation with lookahead %10.6fus\n", lookahead_.usec());
+  TimeDelta lookahead = computeLookahead();
+  if (partition_lookahead_ && nproc_ > 1){
+    int64_t min_ticks = rt_->allreduceMin(lookahead.ticks());
+    int64_t max_ticks = rt_->allreduceMax(lookahead.ticks());
+    if (rt_->me() == 0){
+      printf("Running parallel simulation with partition lookahead %10.6fus to %10.6fus\n",
+             TimeDelta(min_ticks, TimeDelta::exact).usec(),
+             TimeDelta(max_ticks, TimeDelta::exact).usec());
+    }
+  } else if (rt_->me() == 0){
+    printf("Running parallel simulation with lookahead %10.6fus\n", lookahead.usec());
+  }
+  if (overlap_epochs_ && rt_->me() == 0){
+    printf("Overlapping epochs with eager sends of %zu bytes\n", eager_bytes_);
   }
   uint64_t epoch = 0;
 
   while (lower_bound != no_events_left_time || num_loops_left > 0){
-    Timestamp horizon = lower_bound + lookahead_;
+    Timestamp horizon = lower_bound + lookahead;
     event_debug("running from %10.6e->%10.6e for lookahead %10.6e",
-                lower_bound.sec(), horizon.sec(), lookahead_.sec());
+                lower_bound.sec(), horizon.sec(), lookahead.sec());
     auto t_start = rdtsc();
     Timestamp min_time = runEvents(horizon);
     auto t_run = rdtsc();
-    lower_bound = receiveIncomingEvents(min_time);
+    lower_bound = nextLowerBound(lower_bound, min_time);
     auto t_stop = rdtsc();
     uint64_t event = t_run - t_start;
     uint64_t barrier = t_stop - t_run;
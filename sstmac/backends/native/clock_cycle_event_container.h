@@ -95,8 +95,45 @@ class ClockCycleEventMap :
 
   void computeFinalTime(Timestamp vote);
 
+  /**
+   * @brief nextLowerBound Exchange events with other LPs at the end of an epoch.
+   *        With overlapped epochs, the global vote completes one epoch late and the
+   *        bound is the larger of the previous horizon and the last completed vote.
+   * @param lower_bound The lower bound the epoch started from
+   * @param vote The minimum event time I have
+   * @return The lower bound on all event times for the next epoch
+   */
+  Timestamp nextLowerBound(Timestamp lower_bound, Timestamp vote);
+
+  /**
+   * @brief initOverlap If running overlapped epochs, tell the runtime
+   *        which LPs this LP exchanges events with
+   */
+  void initOverlap();
+
+  /**
+   * @brief scheduleIncomingBuffers Unpack and schedule all events in the runtime's
+   *        receive buffers after an exchange, then reset the buffers
+   */
+  void scheduleIncomingBuffers();
+
+  /**
+   * @brief computeLookahead
+   * @return The lookahead this LP can use to compute its horizon. In global mode,
+   *         this is the minimum link latency across the whole interconnect.
+   *         In partition mode, this is the minimum latency on any link from
+   *         another LP into this one.
+   */
+  TimeDelta computeLookahead();
+
   int num_profile_loops_;
 
+  bool partition_lookahead_;
+
+  bool overlap_epochs_;
+
+  size_t eager_bytes_;
+
  private:
   void run() override;
 
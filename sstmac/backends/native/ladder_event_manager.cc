@@ -0,0 +1,129 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#define __STDC_FORMAT_MACROS
+#include <sstmac/common/sstmac_config.h>
+#if !SSTMAC_INTEGRATED_SST_CORE
+#include <sstmac/backends/native/ladder_event_manager.h>
+#include <sstmac/backends/common/parallel_runtime.h>
+#include <sprockit/output.h>
+#include <cinttypes>
+
+#define prll_debug(...) \
+  debug_printf(sprockit::dbg::parallel, "LP %d: %s", rt_->me(), sprockit::sprintf(__VA_ARGS__).c_str())
+
+namespace sstmac {
+namespace native {
+
+LadderEventManager::LadderEventManager(SST::Params& params, ParallelRuntime* rt) :
+  EventManager(params, rt)
+{
+}
+
+void
+LadderEventManager::schedule(ExecutionEvent* ev)
+{
+#if SSTMAC_SANITY_CHECK
+  if (ev->time() < now_){
+    spkt_abort_printf("Time went backwards on manager %d:%d to t=%10.6e for link=%" PRIu64 " seq=%" PRIu32,
+                      me_, thread_id_, ev->time().sec(), ev->linkId(), ev->seqnum());
+  }
+#endif
+  if (scheduleIntoBatch(ev)) return;
+
+  queue_.push(ev);
+}
+
+void
+LadderEventManager::stop()
+{
+  printf("Shutting down simulation at t=%20.12fs\n", now().sec());
+  clearBatch();
+  queue_.forEach([](ExecutionEvent* ev){ delete ev; });
+  queue_.clear();
+  min_ipc_time_ = no_events_left_time;
+  stopped_ = true;
+}
+
+Timestamp
+LadderEventManager::runEvents(Timestamp event_horizon)
+{
+  registerPending();
+  min_ipc_time_ = no_events_left_time;
+  prll_debug("manager %d:%d running to horizon %10.5e with %llu events in queue on epoch %d",
+             me_, thread_id_, event_horizon.sec(), queue_.size(), epoch());
+  while (!queue_.empty()){
+    if (!inbox_.empty()){
+      drainInbox();
+    }
+    ExecutionEvent* ev = queue_.top();
+#if SSTMAC_SANITY_CHECK
+    if (ev->time() < now_){
+      spkt_abort_printf("Time went backwards on manager %d:%d to t=%10.6e for link=%" PRIu64 " for seqnum=%" PRIu32,
+                        me_, thread_id_, ev->time().sec(), ev->linkId(), ev->seqnum());
+    }
+#endif
+    if (ev->time() >= event_horizon){
+      flushOutbox();
+      return std::min(min_ipc_time_, ev->time());
+    } else if (batch_dispatch_){
+      now_ = ev->time();
+      queue_.popBatch(batch_);
+      runBatch();
+    } else {
+      now_ = ev->time();
+      queue_.pop();
+      ev->execute();
+      delete ev;
+      ++num_events_run_;
+    }
+  }
+  flushOutbox();
+  return min_ipc_time_;
+}
+
+}
+}
+
+#endif // !SSTMAC_INTEGRATED_SST_CORE
@@ -0,0 +1,104 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef SSTMAC_BACKENDS_NATIVE_LADDER_EVENT_MANAGER_H
+#define SSTMAC_BACKENDS_NATIVE_LADDER_EVENT_MANAGER_H
+
+#include <sstmac/common/sstmac_config.h>
+#if !SSTMAC_INTEGRATED_SST_CORE
+
+#include <sstmac/common/event_manager.h>
+#include <sstmac/common/ladder_queue.h>
+
+namespace sstmac {
+namespace native {
+
+/**
+ * @brief The LadderEventManager class
+ * Serial event manager that replaces the sorted set of the "map"
+ * event manager with a ladder queue. Events run in exactly the same
+ * (time, link, seqnum) order as "map", so results are identical.
+ */
+class LadderEventManager :
+  public EventManager
+{
+ public:
+  SST_ELI_REGISTER_DERIVED(
+    EventManager,
+    LadderEventManager,
+    "macro",
+    "ladder",
+    SST_ELI_ELEMENT_VERSION(1,0,0),
+    "Implements a serial event manager with an O(1) amortized ladder queue")
+
+  LadderEventManager(SST::Params& params, ParallelRuntime* rt);
+
+  ~LadderEventManager() override {}
+
+  void schedule(ExecutionEvent* ev) override;
+
+  Timestamp runEvents(Timestamp event_horizon) override;
+
+  void stop() override;
+
+  Timestamp minEventTime() const override {
+    return queue_.empty() ? no_events_left_time : queue_.top()->time();
+  }
+
+  size_t numEvents() const override {
+    return queue_.size();
+  }
+
+ private:
+  //peeking at the top may redistribute rungs, but doesn't change the contents
+  mutable LadderQueue<EventCompare> queue_;
+
+};
+
+}
+}
+
+#endif // !SSTMAC_INTEGRATED_SST_CORE
+
+#endif // SSTMAC_BACKENDS_NATIVE_LADDER_EVENT_MANAGER_H
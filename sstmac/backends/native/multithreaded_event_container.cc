@@ -53,9 +53,10 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <iostream>
 #include <sstream>
 #include <limits>
+#include <algorithm>
 #include <sstmac/hardware/interconnect/interconnect.h>
+#include <sstmac/software/process/thread_info.h>
 #include <sprockit/keyword_registration.h>
-#include <sprockit/thread_safe.h>
 #include <cinttypes>
 
 RegisterDebugSlot(multithread);
@@ -63,38 +64,32 @@ RegisterDebugSlot(cpu_affinity);
 
 RegisterKeywords(
  { "cpu_affinity", "the CPU offset for binding threads to core" },
+ { "busy_loop_count", "the number of no-op loops between checks of a barrier flag" },
+ { "barrier_fanout", "the maximum number of children of each thread in the barrier tree" },
+ { "barrier_spin_count", "the number of checks of a barrier flag before sleeping, 0 to always spin" },
+ { "barrier_wait_cycles", "the cycles each thread spends waiting in the barrier each epoch" },
+ { "work_unit_steal_interval", "the number of epochs between moving thread work units from busy to idle threads, 0 to never move them" },
 );
 
-static int busy_loop_count = 200;
 static int epoch_print_interval = 10000;
 
-static uint64_t event_cycles = 0;
-static uint64_t barrier_cycles = 0;
-
-static inline void busy_loop(){
-  //checking back often enough - but without thrashing the variable
-  for (int i=0; i < busy_loop_count; ++i){
-    __asm__ __volatile__("");
-  }
-}
-
 static int64_t terminate_sentinel = std::numeric_limits<int64_t>::max();
 
 namespace sstmac {
 namespace native {
 
-#define atomic_is_zero(x) \
-  (add_int64_atomic(int32_t(0), x) == 0)
-  //*x == 0
-
-static inline void wait_on_child_completion(threadQueue* q, Timestamp& min_time)
+static Timestamp run_work_units(std::vector<EventManager*>& units, Timestamp horizon)
 {
-  bool done = atomic_is_zero(q->delta_t);
-  while (!done){
-    busy_loop(); //don't slam the variable too hard
-    done = atomic_is_zero(q->delta_t);
+  //memory pools and the active OS are looked up by thread id,
+  //so while running a unit this thread takes on the unit's id
+  int my_thread_id = ThreadInfo::currentPhysicalThreadId();
+  Timestamp min_time = EventManager::no_events_left_time;
+  for (EventManager* mgr : units){
+    ThreadInfo::setCurrentPhysicalThreadId(mgr->thread());
+    min_time = std::min(min_time, mgr->runEvents(horizon));
   }
-  min_time = std::min(min_time, q->min_time);
+  ThreadInfo::setCurrentPhysicalThreadId(my_thread_id);
+  return min_time;
 }
 
 static void
@@ -102,32 +97,26 @@ pthread_run_worker_thread(void* args)
 {
   threadQueue* q = (threadQueue*) args;
   Timestamp horizon;
-  uint64_t epoch = 0;
   debug_printf(sprockit::dbg::parallel, "spun up subthread");
+  q->barrier->initThread(q->id, [q]{
+    //pull in events early so my inboxes do not fill up
+    for (EventManager* mgr : q->units){
+      mgr->drainInbox();
+    }
+  });
   while(1){
-    bool stillZero = atomic_is_zero(q->delta_t);
-    if (!stillZero){
-      int64_t delta_t = *q->delta_t;
-      if (q->child1) add_int64_atomic(delta_t, q->child1->delta_t);
-      if (q->child2) add_int64_atomic(delta_t, q->child2->delta_t);
-      if (delta_t == terminate_sentinel){
-        return;
-      } else if (delta_t != 0) {
-        horizon += TimeDelta(delta_t, TimeDelta::exact);
-        Timestamp new_min_time = q->mgr->runEvents(horizon);
-        debug_printf(sprockit::dbg::parallel, "manager %d:%d voting for minimum time %10.7e on epoch %d",
-                    q->mgr->me(), q->mgr->thread(), new_min_time.sec(), q->mgr->epoch());
-        q->min_time = new_min_time;
-      }
-      if (q->child1) wait_on_child_completion(q->child1, q->min_time);
-      if (q->child2) wait_on_child_completion(q->child2, q->min_time);
-      add_int64_atomic(-delta_t, q->delta_t);
-      ++epoch;
-    } else {
-      busy_loop(); //don't slam the variable too hard
+    uint64_t wait_cycles = 0;
+    int64_t delta_t = q->barrier->waitForRelease(q->id, wait_cycles);
+    if (delta_t == terminate_sentinel){
+      return;
     }
+    horizon += TimeDelta(delta_t, TimeDelta::exact);
+    Timestamp min_time = run_work_units(q->units, horizon);
+    debug_printf(sprockit::dbg::parallel, "manager %d:%d voting for minimum time %10.7e over %d units on epoch %d",
+                 q->mgr->me(), q->mgr->thread(), min_time.sec(), int(q->units.size()), q->mgr->epoch());
+    q->barrier->combine(q->id, min_time, wait_cycles);
+    q->wait_stat->addData(wait_cycles);
   }
-  return;
 }
 
 static void*
@@ -155,23 +144,52 @@ MultithreadedEventContainer::MultithreadedEventContainer(
     //it would be nice to check that size of cpu_offsets matches task per node
   }
 
-  busy_loop_count = params.find<int>("busy_loop_count", busy_loop_count);
+  int busy_loop_count = params.find<int>("busy_loop_count", 200);
+  int fanout = params.find<int>("barrier_fanout", 2);
+  int spin_count = params.find<int>("barrier_spin_count", 0);
+  steal_interval_ = params.find<int>("work_unit_steal_interval", 100);
+  num_steals_ = 0;
 
-  num_subthreads_ = rt->nthread() - 1;
+  num_subthreads_ = rt->nworker() - 1;
+  num_units_ = rt->nthread();
 
-  queues_.resize(num_subthreads_);
+  queues_.resize(num_subthreads_ + 1);
   pthreads_.resize(num_subthreads_);
   pthread_attrs_.resize(num_subthreads_);
-  thread_managers_.resize(num_subthreads_);
+  thread_managers_.resize(num_units_ - 1);
+  last_events_run_.resize(num_units_);
 
-  for (int i=0; i < num_subthreads_; ++i){
+  for (int i=0; i < thread_managers_.size(); ++i){
     thread_managers_[i] = new EventManager(params, rt);
     thread_managers_[i]->setThread(i);
   }
-  setThread(num_subthreads_);
+  setThread(num_units_ - 1);
+
+  //start with a block of consecutive units on each thread,
+  //the main thread runs the last block which includes this manager
+  int nworker = num_subthreads_ + 1;
+  for (int u=0; u < num_units_; ++u){
+    int worker = u * nworker / num_units_;
+    workerUnits(worker).push_back(threadManager(u));
+  }
+
+  barrier_ = new ThreadBarrier(nworker, fanout, busy_loop_count, spin_count);
+
+  SST::Params stat_params = params.get_scoped_params("barrier_wait_cycles");
+  auto stat_type = stat_params.find<std::string>("type", "null");
+  auto* builder = Statistic<uint64_t>::getBuilderLibrary("macro")->getBuilder(stat_type);
+  if (!builder){
+    spkt_abort_printf("Bad stat type '%s' given for statistic 'barrier_wait_cycles'",
+                      stat_type.c_str());
+  }
 
   for (int i=0; i < queues_.size(); ++i){
-    queues_[i].mgr = thread_managers_[i];
+    threadQueue& q = queues_[i];
+    q.mgr = q.units.front();
+    q.barrier = barrier_;
+    q.id = i;
+    q.wait_stat = builder->create(nullptr, "barrier_wait_cycles", std::to_string(i), stat_params);
+    registerStatisticCore(q.wait_stat, stat_params);
   }
 
   for (int i=0; i < num_subthreads_; ++i){
@@ -182,51 +200,82 @@ MultithreadedEventContainer::MultithreadedEventContainer(
   }
 }
 
+MultithreadedEventContainer::~MultithreadedEventContainer() throw ()
+{
+  delete barrier_;
+}
+
 void
 MultithreadedEventContainer::scheduleStop(Timestamp until)
 {
-  for (int i=0; i < num_subthreads_; ++i){
-    EventManager* mgr = thread_managers_[i];
+  for (EventManager* mgr : thread_managers_){
     mgr->scheduleStop(until);
   }
   EventManager::scheduleStop(until);
 }
 
 void
-MultithreadedEventContainer::runWork()
+MultithreadedEventContainer::stealWorkUnits()
 {
-  //make the binary spanning tree for the thread barrier
-  threadQueue* child1 = nullptr;
-  threadQueue* child2 = nullptr;
-  if (num_subthreads_ >= 1){
-    child1 = &queues_[0]; 
+  int nworker = num_subthreads_ + 1;
+  std::vector<uint64_t> unit_load(num_units_);
+  for (int u=0; u < num_units_; ++u){
+    uint64_t total = threadManager(u)->numEventsRun();
+    unit_load[u] = total - last_events_run_[u];
+    last_events_run_[u] = total;
   }
-  if (num_subthreads_ >= 2){
-    child2 = &queues_[1];
+
+  std::vector<uint64_t> load(nworker, 0);
+  for (int w=0; w < nworker; ++w){
+    for (EventManager* mgr : workerUnits(w)){
+      load[w] += unit_load[mgr->thread()];
+    }
   }
 
-  int last_level_offset = 0;
-  int level_offset = 2;
-  int level_size = 4;
-  while (level_offset < num_subthreads_){
-    int maxChild = std::min(level_offset+level_size,num_subthreads_);
-    for (int c=level_offset; c < maxChild; ++c){
-      int child_offset = c - level_offset;
-      int parent_offset = child_offset / 2;
-      int child_number = child_offset % 2;
-      int parent = last_level_offset + parent_offset;
-      threadQueue& parentQ = queues_[parent];
-      if (child_number == 0){
-        parentQ.child1 = &queues_[c];
-      } else {
-        parentQ.child2 = &queues_[c];
+  //the idlest thread steals the unit from the busiest thread that best evens them out
+  //the assignment only changes which thread runs a unit, never the order of its events
+  for (int i=0; i < num_units_; ++i){
+    int busy = std::max_element(load.begin(), load.end()) - load.begin();
+    int idle = std::min_element(load.begin(), load.end()) - load.begin();
+    uint64_t gap = load[busy] - load[idle];
+    std::vector<EventManager*>& victim = workerUnits(busy);
+    int best = -1;
+    uint64_t best_gap = gap;
+    for (int idx=0; idx < victim.size(); ++idx){
+      uint64_t l = unit_load[victim[idx]->thread()];
+      if (l == 0 || l >= gap) continue;
+      uint64_t new_gap = gap > 2*l ? gap - 2*l : 2*l - gap;
+      if (new_gap < best_gap){
+        best = idx;
+        best_gap = new_gap;
       }
     }
-    last_level_offset = level_offset;
-    level_offset += level_size;
-    level_size *= 2;
+    if (best < 0) break;
+
+    EventManager* unit = victim[best];
+    uint64_t l = unit_load[unit->thread()];
+    victim.erase(victim.begin() + best);
+    workerUnits(idle).push_back(unit);
+    load[busy] -= l;
+    load[idle] += l;
+    ++num_steals_;
+    debug_printf(sprockit::dbg::multithread,
+                 "thread %d stole unit %d with %" PRIu64 " events from thread %d",
+                 idle, unit->thread(), l, busy);
   }
-  
+}
+
+void
+MultithreadedEventContainer::runWork()
+{
+  threadQueue& main_q = queues_[num_subthreads_];
+  barrier_->initThread(main_q.id, [this]{
+    //pull in events early so my inboxes do not fill up
+    for (EventManager* mgr : queues_[num_subthreads_].units){
+      mgr->drainInbox();
+    }
+  });
+
   Timestamp last_horizon;
   Timestamp lower_bound;
   uint64_t epoch = 0;
@@ -254,29 +303,32 @@ MultithreadedEventContainer::runWork()
       spkt_abort_printf("Time did not advance - caught in infinite time loop");
     }
 
-    if (child1) add_int64_atomic(delta_t, child1->delta_t);
-    if (child2) add_int64_atomic(delta_t, child2->delta_t);
+    barrier_->release(delta_t);
 
-    auto t_start = rdtsc();
-    Timestamp min_time = runEvents(horizon);
+    Timestamp min_time = run_work_units(main_q.units, horizon);
 
-    auto t_run = rdtsc();
+    uint64_t wait_cycles = 0;
+    min_time = barrier_->combine(main_q.id, min_time, wait_cycles);
+    main_q.wait_stat->addData(wait_cycles);
+
+    //all threads are paused - hand over anything that did not fit in an inbox
+    for (auto mgr : thread_managers_){
+      mgr->deliverHeldEvents();
+    }
+    deliverHeldEvents();
 
-    if (child1) wait_on_child_completion(child1, min_time);
-    if (child2) wait_on_child_completion(child2, min_time);
+    if (num_units_ > num_subthreads_ + 1 && steal_interval_ > 0
+        && (epoch+1) % steal_interval_ == 0){
+      stealWorkUnits();
+    }
 
     if (stopped_){
       lower_bound = no_events_left_time; //done
     } else {
-      lower_bound = receiveIncomingEvents(min_time);
+      lower_bound = nextLowerBound(lower_bound, min_time);
     }
     if (num_loops_left > 0) --num_loops_left;
     last_horizon = horizon;
-    auto t_stop = rdtsc();
-    uint64_t event = t_run - t_start;
-    uint64_t barrier = t_stop - t_run;
-    event_cycles += event;
-    barrier_cycles += barrier;
     if (epoch % epoch_print_interval == 0 && rt_->me() == 0){
       debug_printf(sprockit::dbg::multithread,
            "Epoch %-10" PRIu64 " ran until horizon %" PRIu64 ":%" PRIu64 " - new bound = %" PRIu64 ":%" PRIu64 "\n",
@@ -286,10 +338,13 @@ MultithreadedEventContainer::runWork()
     ++epoch;
   }
 
-  if (child1) add_int64_atomic(terminate_sentinel, child1->delta_t);
-  if (child2) add_int64_atomic(terminate_sentinel, child2->delta_t);
+  barrier_->release(terminate_sentinel);
 
   if (rt_->me() == 0) printf("Ran %" PRIu64 " epochs in multithreading run\n", epoch);
+  if (rt_->me() == 0 && num_units_ > num_subthreads_ + 1){
+    printf("Threads stole work units %" PRIu64 " times among %d units on %d threads\n",
+           num_steals_, num_units_, num_subthreads_ + 1);
+  }
 
 }
 
@@ -301,6 +356,7 @@ MultithreadedEventContainer::run()
   for (auto mgr : thread_managers_){
     mgr->setInterconnect(interconn_);
   }
+  initOverlap();
 
   int nthread_ = nthread();
   debug_printf(sprockit::dbg::event_manager,
@@ -325,6 +381,16 @@ MultithreadedEventContainer::run()
   sched_setaffinity(0,sizeof(cpu_set_t), &cpuset);
 #endif
 
+  //keep threads on the same NUMA node in the same subtree of the barrier
+  std::vector<int> numa_nodes(num_subthreads_ + 1, 0);
+#if SSTMAC_USE_CPU_AFFINITY
+  numa_nodes[num_subthreads_] = numaNodeOfCpu(task_affinity);
+  for (int i=0; i < num_subthreads_; ++i){
+    numa_nodes[i] = numaNodeOfCpu(task_affinity + i + 1);
+  }
+#endif
+  barrier_->buildTree(numa_nodes);
+
   //launch all the subthreads - don't launch zero
   //main thread will do zero's work
   int status;
@@ -371,10 +437,15 @@ MultithreadedEventContainer::run()
     if (status != 0){
         sprockit::abort("multithreaded_event_container::run: failed joining pthread");
     }
-    final_time = std::max(final_time, thread_managers_[i]->now());
+  }
+
+  for (EventManager* mgr : thread_managers_){
+    final_time = std::max(final_time, mgr->now());
   }
 
   computeFinalTime(final_time);
+
+  finalizeStatsOutput();
 }
 
 
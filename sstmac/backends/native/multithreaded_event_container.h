@@ -49,6 +49,8 @@ Questions? Contact sst-macro-help@sandia.gov
 #if !SSTMAC_INTEGRATED_SST_CORE
 
 #include <sstmac/backends/native/clock_cycle_event_container.h>
+#include <sstmac/backends/native/thread_barrier.h>
+#include <sstmac/common/stats/stat_collector.h>
 #include <pthread.h>
 #include <stdlib.h>
 
@@ -60,31 +62,28 @@ namespace native {
 
 class MultithreadedEventContainer;
 
+/** The state of one worker thread, which runs one or more thread work units */
 struct threadQueue
 {
   threadQueue() :
     mgr(nullptr),
-    child1(nullptr),
-    child2(nullptr)
+    barrier(nullptr),
+    id(0),
+    wait_stat(nullptr)
   {
-    void* ptr = &delta_t;
-    int rc = posix_memalign((void**)ptr, sizeof(void*), sizeof(int64_t));
-    if (rc != 0){
-      spkt_abort_printf("Failed to allocated aligned memory: %d\n%s",
-                        rc, ::strerror(rc));
-    }
-    *delta_t = 0;
   }
 
-  volatile int64_t* delta_t;
-  Timestamp min_time;
+  /** The manager whose stack the thread runs on */
   EventManager* mgr;
-  threadQueue* child1;
-  threadQueue* child2;
-
+  /** The thread work units this thread runs each epoch, can change between epochs */
+  std::vector<EventManager*> units;
+  ThreadBarrier* barrier;
+  /** The position of this thread in the barrier, the main thread is last */
+  int id;
+  /** The cycles spent waiting in the barrier each epoch */
+  Statistic<uint64_t>* wait_stat;
 };
 
-
 class MultithreadedEventContainer :
   public ClockCycleEventMap
 {
@@ -99,14 +98,14 @@ class MultithreadedEventContainer :
 
   MultithreadedEventContainer(SST::Params& params, ParallelRuntime* rt);
 
-  ~MultithreadedEventContainer() throw () override {}
+  ~MultithreadedEventContainer() throw () override;
 
   void run() override;
 
   void scheduleStop(Timestamp until) override;
 
   EventManager* threadManager(int thr) const override {
-    if (thr == num_subthreads_) {
+    if (thr == num_units_ - 1) {
       return const_cast<MultithreadedEventContainer*>(this);
     } else {
       return thread_managers_[thr];
@@ -116,11 +115,30 @@ class MultithreadedEventContainer :
  private:
   int num_subthreads_;
 
+  int num_units_;
+
   std::vector<EventManager*> thread_managers_;
 
+  int steal_interval_;
+  uint64_t num_steals_;
+  std::vector<uint64_t> last_events_run_;
+
   void runWork();
 
+  std::vector<EventManager*>& workerUnits(int worker){
+    return queues_[worker].units;
+  }
+
+  /**
+   * @brief stealWorkUnits Move whole work units from the busiest threads to the
+   *        idlest threads based on the events each unit ran since the last call.
+   *        Only called while all threads are paused between epochs.
+   */
+  void stealWorkUnits();
+
+  /** One per thread, the main thread is last */
   std::vector<threadQueue> queues_;
+  ThreadBarrier* barrier_;
   std::vector<int> cpu_affinity_;
   std::vector<pthread_t> pthreads_;
   std::vector<pthread_attr_t> pthread_attrs_;
@@ -0,0 +1,173 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <sstmac/common/sstmac_config.h>
+#if !SSTMAC_INTEGRATED_SST_CORE
+#include <sstmac/backends/native/null_message_event_container.h>
+#include <sstmac/hardware/interconnect/interconnect.h>
+#include <sprockit/keyword_registration.h>
+#include <limits>
+#include <map>
+
+#define event_debug(...) \
+  debug_printf(sprockit::dbg::parallel, "manager %d:%d %s", \
+    rt_->me(), thread_id_, sprockit::sprintf(__VA_ARGS__).c_str())
+
+RegisterKeywords(
+  { "null_message_vote_interval", "the number of null message rounds between global votes for termination" },
+);
+
+namespace sstmac {
+namespace native {
+
+static inline Timestamp
+addLatency(Timestamp t, TimeDelta latency)
+{
+  return t == EventManager::no_events_left_time ? t : t + latency;
+}
+
+NullMessageEventMap::NullMessageEventMap(SST::Params& params, ParallelRuntime* rt) :
+  ClockCycleEventMap(params, rt)
+{
+  vote_interval_ = params.find<int>("null_message_vote_interval", 100);
+  if (vote_interval_ <= 0){
+    spkt_abort_printf("null_message_vote_interval must be positive, got %d", vote_interval_);
+  }
+  if (nthread() > 1){
+    spkt_abort_printf("null_message_parallel event manager does not support multiple threads per rank");
+  }
+}
+
+void
+NullMessageEventMap::collectNeighbors()
+{
+  for (auto& pair : outgoingLatencies()){
+    send_to_.push_back(pair.first);
+    send_latencies_.push_back(pair.second);
+  }
+  promises_.resize(send_to_.size());
+
+  for (auto& pair : incomingLatencies()){
+    recv_from_.push_back(pair.first);
+    recv_latencies_.push_back(pair.second);
+    //nothing can be sent before time zero
+    clocks_.push_back(Timestamp() + pair.second);
+  }
+}
+
+Timestamp
+NullMessageEventMap::voteLowerBound()
+{
+  Timestamp next = stopped_ ? no_events_left_time : minEventTime();
+  int64_t vote = std::min(next.time.ticks(), uint64_t(std::numeric_limits<int64_t>::max()));
+  int64_t min_ticks = rt_->allreduceMin(vote);
+  if (min_ticks == std::numeric_limits<int64_t>::max()){
+    return no_events_left_time;
+  } else {
+    return Timestamp(0, min_ticks);
+  }
+}
+
+void
+NullMessageEventMap::run()
+{
+  interconn_->setup();
+  collectNeighbors();
+
+  if (rt_->me() == 0){
+    printf("Running parallel simulation with null messages, global vote every %d rounds\n",
+           vote_interval_);
+  }
+
+  uint64_t round = 0;
+  uint64_t num_null_messages = 0;
+  while (true){
+    Timestamp horizon = no_events_left_time;
+    for (Timestamp& clock : clocks_){
+      horizon = std::min(horizon, clock);
+    }
+    event_debug("running round %" PRIu64 " to horizon %10.6e", round, horizon.sec());
+    Timestamp min_time = runEvents(horizon);
+
+    //I can only send events while running an event - either one already in my queue
+    //or one that arrives from a neighbor at or after my current horizon
+    Timestamp send_bound = stopped_ ? no_events_left_time : std::min(min_time, horizon);
+    for (int i=0; i < send_to_.size(); ++i){
+      promises_[i] = addLatency(send_bound, send_latencies_[i]);
+    }
+
+    num_null_messages += send_to_.size();
+    rt_->sendRecvNeighbors(send_to_, promises_, recv_from_, clocks_);
+    scheduleIncomingBuffers();
+    ++round;
+
+    if (round % vote_interval_ == 0){
+      //every event sent this round was also received this round,
+      //so the minimum over all event queues is an exact lower bound
+      Timestamp lower_bound = voteLowerBound();
+      if (lower_bound == no_events_left_time){
+        break;
+      }
+      for (int i=0; i < recv_from_.size(); ++i){
+        clocks_[i] = std::max(clocks_[i], lower_bound + recv_latencies_[i]);
+      }
+    }
+  }
+  computeFinalTime(now_);
+
+  uint64_t num_neighbors = send_to_.size();
+  uint64_t max_neighbors = rt_->globalMax(num_neighbors);
+  if (rt_->me() == 0){
+    printf("Ran %" PRIu64 " null message rounds with at most %" PRIu64 " neighbors per LP\n",
+           round, max_neighbors);
+  }
+  event_debug("sent %" PRIu64 " channel clock updates", num_null_messages);
+}
+
+}
+}
+
+#endif // !SSTMAC_INTEGRATED_SST_CORE
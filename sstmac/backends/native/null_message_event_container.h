@@ -0,0 +1,114 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef NULL_MESSAGE_EVENT_CONTAINER_H
+#define NULL_MESSAGE_EVENT_CONTAINER_H
+
+#include <sstmac/common/sstmac_config.h>
+#if !SSTMAC_INTEGRATED_SST_CORE
+
+#include <sstmac/backends/native/clock_cycle_event_container.h>
+
+namespace sstmac {
+namespace native {
+
+/**
+ * @brief The NullMessageEventMap class
+ * Conservative parallel event queue using the Chandy-Misra-Bryant null message protocol.
+ * Instead of a global vote every epoch, each LP only exchanges events and channel clocks
+ * with the LPs it actually shares links with. The channel clock from a neighbor is a promise
+ * that no event will ever arrive from it earlier than that time, so each LP can run
+ * up to the minimum of its incoming channel clocks. A global vote is still done
+ * every few rounds to detect termination and skip over idle periods.
+ */
+class NullMessageEventMap :
+  public ClockCycleEventMap
+{
+ public:
+  SST_ELI_REGISTER_DERIVED(
+    EventManager,
+    NullMessageEventMap,
+    "macro",
+    "null_message_parallel",
+    SST_ELI_ELEMENT_VERSION(1,0,0),
+    "Implements a parallel event queue with null messages exchanged only between neighboring LPs")
+
+  NullMessageEventMap(SST::Params& params, ParallelRuntime* rt);
+
+  ~NullMessageEventMap() throw() override {}
+
+ private:
+  void run() override;
+
+  /**
+   * @brief collectNeighbors Build the list of LPs I send to and receive from
+   *        from the remote links created by the interconnect
+   */
+  void collectNeighbors();
+
+  /**
+   * @brief voteLowerBound Global vote on the minimum event time.
+   *        Only valid directly after a neighbor exchange when no events are in flight.
+   * @return The minimum event time across all LPs
+   */
+  Timestamp voteLowerBound();
+
+  std::vector<int> send_to_;
+  std::vector<TimeDelta> send_latencies_;
+  std::vector<Timestamp> promises_;
+
+  std::vector<int> recv_from_;
+  std::vector<TimeDelta> recv_latencies_;
+  std::vector<Timestamp> clocks_;
+
+  int vote_interval_;
+
+};
+
+}
+}
+
+#endif // !SSTMAC_INTEGRATED_SST_CORE
+
+#endif // NULL_MESSAGE_EVENT_CONTAINER_H
@@ -0,0 +1,274 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <sstmac/common/sstmac_config.h>
+#if !SSTMAC_INTEGRATED_SST_CORE
+#include <sstmac/backends/native/thread_barrier.h>
+#include <sstmac/backends/native/clock_cycle_event_container.h>
+#include <sprockit/errors.h>
+#include <map>
+#include <climits>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace sstmac {
+namespace native {
+
+ThreadBarrier::ThreadBarrier(int nthread, int fanout, int busy_loop_count, int spin_count) :
+  nthread_(nthread),
+  fanout_(fanout),
+  busy_loop_count_(busy_loop_count),
+  spin_count_(spin_count),
+  all_initialized_(false),
+  nodes_(nthread, nullptr),
+  idle_(nthread),
+  parents_(nthread, -1),
+  children_(nthread),
+  num_initialized_(0)
+{
+  static_assert(sizeof(Flag) == cache_line_size, "barrier flags must fill exactly one cache line");
+  if (fanout_ < 1){
+    spkt_abort_printf("barrier_fanout must be at least 1, got %d", fanout_);
+  }
+#ifndef __linux__
+  //no futexes, always spin
+  spin_count_ = 0;
+#endif
+}
+
+ThreadBarrier::~ThreadBarrier()
+{
+  for (Node* node : nodes_){
+    if (node){
+      node->~Node();
+      free(node);
+    }
+  }
+}
+
+void
+ThreadBarrier::addSubtree(const std::vector<int>& order)
+{
+  //order[0] is the subtree root, the rest form a heap of the given fanout
+  for (int i=1; i < order.size(); ++i){
+    int parent = order[(i-1)/fanout_];
+    parents_[order[i]] = parent;
+    children_[parent].push_back(order[i]);
+  }
+}
+
+void
+ThreadBarrier::buildTree(const std::vector<int>& numa_nodes)
+{
+  int root = nthread_ - 1;
+  std::map<int,std::vector<int>> groups;
+  groups[numa_nodes[root]].push_back(root);
+  for (int t=0; t < root; ++t){
+    groups[numa_nodes[t]].push_back(t);
+  }
+
+  //each NUMA node gets its own subtree, then the first thread
+  //on each node joins a subtree of leaders under the root
+  std::vector<int> leaders;
+  leaders.push_back(root);
+  for (auto& pair : groups){
+    std::vector<int>& members = pair.second;
+    if (members[0] != root){
+      leaders.push_back(members[0]);
+    }
+    addSubtree(members);
+  }
+  addSubtree(leaders);
+}
+
+void
+ThreadBarrier::initThread(int thr, std::function<void()> idle)
+{
+  //allocate on this thread so first touch puts it on this thread's NUMA node
+  void* mem = nullptr;
+  int rc = posix_memalign(&mem, sysconf(_SC_PAGESIZE), sizeof(Node));
+  if (rc != 0){
+    spkt_abort_printf("Failed to allocate aligned barrier memory: %d\n%s",
+                      rc, ::strerror(rc));
+  }
+  Node* node = new (mem) Node;
+  node->release.count.store(0, std::memory_order_relaxed);
+  node->release.sleepers.store(0, std::memory_order_relaxed);
+  node->done.count.store(0, std::memory_order_relaxed);
+  node->done.sleepers.store(0, std::memory_order_relaxed);
+  node->epoch = 0;
+  nodes_[thr] = node;
+  idle_[thr] = idle;
+  num_initialized_.fetch_add(1, std::memory_order_release);
+}
+
+void
+ThreadBarrier::post(Flag& flag)
+{
+  //sequentially consistent so that either the waiter sees the new count
+  //or I see that the waiter went to sleep
+  flag.count.fetch_add(1);
+#ifdef __linux__
+  if (spin_count_ && flag.sleepers.load() != 0){
+    syscall(SYS_futex, (int*) &flag.count, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+  }
+#endif
+}
+
+void
+ThreadBarrier::sleep(Flag& flag, uint32_t seen)
+{
+#ifdef __linux__
+  flag.sleepers.fetch_add(1);
+  if (flag.count.load() == seen){
+    syscall(SYS_futex, (int*) &flag.count, FUTEX_WAIT_PRIVATE, int(seen), nullptr, nullptr, 0);
+  }
+  flag.sleepers.fetch_sub(1);
+#endif
+}
+
+uint64_t
+ThreadBarrier::wait(Flag& flag, uint32_t target, const std::function<void()>& idle)
+{
+  uint32_t count = flag.count.load(std::memory_order_acquire);
+  if (count == target) return 0;
+
+  uint64_t start = rdtsc();
+  int spins = 0;
+  while (count != target){
+    if (idle) idle();
+    for (int i=0; i < busy_loop_count_; ++i){
+      __asm__ __volatile__("");
+    }
+    if (spin_count_ && ++spins >= spin_count_){
+      sleep(flag, count);
+      spins = 0;
+    }
+    count = flag.count.load(std::memory_order_acquire);
+  }
+  return rdtsc() - start;
+}
+
+void
+ThreadBarrier::release(int64_t delta_t)
+{
+  int root = nthread_ - 1;
+  if (!all_initialized_){
+    while (num_initialized_.load(std::memory_order_acquire) < nthread_){
+      __asm__ __volatile__("");
+    }
+    all_initialized_ = true;
+  }
+  for (int child : children_[root]){
+    Flag& flag = nodes_[child]->release;
+    flag.delta_t = delta_t;
+    post(flag);
+  }
+}
+
+int64_t
+ThreadBarrier::waitForRelease(int thr, uint64_t& wait_cycles)
+{
+  Node* me = nodes_[thr];
+  //never do idle work here, the root modifies shared state between epochs
+  wait_cycles += wait(me->release, me->epoch + 1, std::function<void()>());
+  int64_t delta_t = me->release.delta_t;
+  for (int child : children_[thr]){
+    Flag& flag = nodes_[child]->release;
+    flag.delta_t = delta_t;
+    post(flag);
+  }
+  return delta_t;
+}
+
+Timestamp
+ThreadBarrier::combine(int thr, Timestamp vote, uint64_t& wait_cycles)
+{
+  Node* me = nodes_[thr];
+  uint32_t target = me->epoch + 1;
+  for (int child : children_[thr]){
+    Flag& flag = nodes_[child]->done;
+    wait_cycles += wait(flag, target, idle_[thr]);
+    vote = std::min(vote, flag.vote);
+  }
+  me->epoch = target;
+  if (parents_[thr] >= 0){
+    me->done.vote = vote;
+    post(me->done);
+  }
+  return vote;
+}
+
+int
+numaNodeOfCpu(int cpu)
+{
+  char path[128];
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+  DIR* dir = opendir(path);
+  if (!dir) return 0;
+
+  int node = 0;
+  struct dirent* entry;
+  while ((entry = readdir(dir))){
+    int id;
+    if (sscanf(entry->d_name, "node%d", &id) == 1){
+      node = id;
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+
+}
+}
+
+#endif
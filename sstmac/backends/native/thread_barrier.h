@@ -0,0 +1,176 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef SSTMAC_BACKENDS_NATIVE_THREAD_BARRIER_H
+#define SSTMAC_BACKENDS_NATIVE_THREAD_BARRIER_H
+
+#include <sstmac/common/timestamp.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+namespace sstmac {
+namespace native {
+
+/**
+ * @brief The ThreadBarrier class
+ * A combining tree barrier for the threads of one rank. The root (the main thread)
+ * releases each epoch down the tree with the amount of time to advance, and the
+ * minimum time votes are combined back up the tree as threads finish.
+ * Every flag sits alone on a cache line, and each thread allocates its own node
+ * so that the memory lands on its NUMA node. Threads on the same NUMA node form a
+ * subtree under a single leader, so only the leaders touch memory on other nodes.
+ * For runs with more threads than cores, waiting threads can stop spinning and
+ * sleep on a futex.
+ */
+class ThreadBarrier
+{
+ public:
+  /**
+   * @param nthread The number of threads, the last one is the root
+   * @param fanout  The maximum number of children of each thread in the tree
+   * @param busy_loop_count The number of no-op loops between checks of a flag
+   * @param spin_count The number of checks before sleeping, 0 to always spin
+   */
+  ThreadBarrier(int nthread, int fanout, int busy_loop_count, int spin_count);
+
+  ~ThreadBarrier();
+
+  /**
+   * @brief buildTree Must be called before any thread starts
+   * @param numa_nodes The NUMA node of each thread
+   */
+  void buildTree(const std::vector<int>& numa_nodes);
+
+  /**
+   * @brief initThread Allocate the calling thread's node. Every thread other
+   *        than the root must call this before its first wait.
+   * @param idle Work to do while spinning on children, must not touch anything
+   *        that another thread modifies between epochs
+   */
+  void initThread(int thr, std::function<void()> idle = std::function<void()>());
+
+  /**
+   * @brief release Root only: wait for all threads to be initialized on the first
+   *        call, then start the next epoch on all threads
+   * @param delta_t The number of ticks to advance the horizon
+   */
+  void release(int64_t delta_t);
+
+  /**
+   * @brief waitForRelease Wait for the parent to start the next epoch and pass it on to my children
+   * @param wait_cycles Incremented by the cycles spent waiting
+   * @return The number of ticks to advance the horizon
+   */
+  int64_t waitForRelease(int thr, uint64_t& wait_cycles);
+
+  /**
+   * @brief combine Wait for my children to finish the epoch and pass the combined vote up the tree
+   * @param vote My own minimum time vote
+   * @param wait_cycles Incremented by the cycles spent waiting
+   * @return The minimum vote over my subtree, which for the root is all threads
+   */
+  Timestamp combine(int thr, Timestamp vote, uint64_t& wait_cycles);
+
+  int parent(int thr) const {
+    return parents_[thr];
+  }
+
+  const std::vector<int>& children(int thr) const {
+    return children_[thr];
+  }
+
+ private:
+  static constexpr int cache_line_size = 64;
+
+  /** A counter one thread bumps and another thread waits on */
+  struct Flag {
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> sleepers;
+    /** Written before count is bumped: the horizon delta on a release,
+        the combined vote when done */
+    int64_t delta_t;
+    Timestamp vote;
+    char pad[cache_line_size - 2*sizeof(uint32_t) - sizeof(int64_t) - sizeof(Timestamp)];
+  };
+
+  struct Node {
+    Flag release;
+    Flag done;
+    /** The number of epochs this thread has finished, only touched by this thread */
+    uint32_t epoch;
+  };
+
+  void addSubtree(const std::vector<int>& order);
+
+  void post(Flag& flag);
+
+  uint64_t wait(Flag& flag, uint32_t target, const std::function<void()>& idle);
+
+  void sleep(Flag& flag, uint32_t seen);
+
+  int nthread_;
+  int fanout_;
+  int busy_loop_count_;
+  int spin_count_;
+  bool all_initialized_;
+  std::vector<Node*> nodes_;
+  std::vector<std::function<void()>> idle_;
+  std::vector<int> parents_;
+  std::vector<std::vector<int>> children_;
+  std::atomic<int> num_initialized_;
+
+};
+
+/**
+ * @brief numaNodeOfCpu
+ * @return The NUMA node that a CPU belongs to, 0 if it cannot be determined
+ */
+int numaNodeOfCpu(int cpu);
+
+}
+}
+
+#endif
@@ -56,12 +56,20 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <sprockit/util.h>
 #include <sprockit/output.h>
 #include <sprockit/thread_safe_new.h>
+#include <sprockit/keyword_registration.h>
 #include <limits>
+#include <algorithm>
 
 #include <cinttypes>
 
 RegisterDebugSlot(event_manager);
 
+RegisterKeywords(
+  { "event_batch_dispatch", "whether to pull and run all events at the same timestamp as a single batch" },
+  { "print_mem_pools", "whether to print the high-water mark of each memory pool at the end of the run" },
+  { "thread_inbox_size", "the number of events each thread's lock-free inbox holds before senders hold events back" },
+);
+
 #define prll_debug(...) \
   debug_printf(sprockit::dbg::parallel, "LP %d: %s", rt_->me(), sprockit::sprintf(__VA_ARGS__).c_str())
 
@@ -106,7 +114,7 @@ void runEventmanagerThread(void* argPtr)
 }
 
 EventManager::EventManager(SST::Params& params, ParallelRuntime *rt) :
-  pendingSlot_(0),
+  has_held_events_(false),
   complete_(false),
   rt_(rt),
   interconn_(nullptr),
@@ -114,14 +122,21 @@ EventManager::EventManager(SST::Params& params, ParallelRuntime *rt) :
   me_(rt->me()),
   nproc_(rt->nproc()),
   nthread_(rt->nthread()),
-  thread_id_(0)
+  thread_id_(0),
+  running_batch_(false),
+  batch_pos_(0),
+  num_batches_(0),
+  num_batched_events_(0),
+  max_batch_size_(0),
+  num_events_run_(0)
 {
-  for (int i=0; i < num_pendingSlots; ++i){
-    pending_events_[i].resize(nthread_);
-  }
   if (nthread_ == 0){
     sprockit::abort("Have zero worker threads! Cannot do any work");
   }
+  if (nthread_ > 1){
+    inbox_.init(params.find<int>("thread_inbox_size", 4096));
+    outbox_.resize(nthread_);
+  }
   SST::Params os_params = params.get_scoped_params("node").get_scoped_params("os");
   sw::StackAlloc::init(os_params);
 
@@ -132,6 +147,9 @@ EventManager::EventManager(SST::Params& params, ParallelRuntime *rt) :
 
   //make sure there's a good bit of space
   pending_serialization_.reserve(1024);
+
+  batch_dispatch_ = params.find<bool>("event_batch_dispatch", false);
+  print_mem_pools_ = params.find<bool>("print_mem_pools", false);
 }
 
 EventManager::~EventManager()
@@ -148,18 +166,39 @@ EventManager::~EventManager()
 }
 
 void
-EventManager::addLinkHandler(uint64_t linkId, EventHandler *handler)
+EventManager::addLinkHandler(uint64_t linkId, EventHandler *handler, int src_rank, TimeDelta latency)
 {
+  if (min_incoming_latency_.ticks() == 0 || latency < min_incoming_latency_){
+    min_incoming_latency_ = latency;
+  }
+  auto iter = incoming_latencies_.find(src_rank);
+  if (iter == incoming_latencies_.end()){
+    incoming_latencies_[src_rank] = latency;
+  } else {
+    iter->second = std::min(iter->second, latency);
+  }
   if (linkId >= link_handlers_.size()){
     link_handlers_.resize(linkId + 1);
   }
   link_handlers_[linkId] = handler;
 }
 
+void
+EventManager::addOutgoingLink(int dst_rank, TimeDelta latency)
+{
+  auto iter = outgoing_latencies_.find(dst_rank);
+  if (iter == outgoing_latencies_.end()){
+    outgoing_latencies_[dst_rank] = latency;
+  } else {
+    iter->second = std::min(iter->second, latency);
+  }
+}
+
 void
 EventManager::stop()
 {
   printf("Shutting down simulation at t=%20.12fs\n", now().sec());
+  clearBatch();
   for (ExecutionEvent* ev : event_queue_){
     delete ev;
   }
@@ -182,6 +221,9 @@ EventManager::runEvents(Timestamp event_horizon)
   prll_debug("manager %d:%d running to horizon %10.5e with %llu events in queue on epoch %d",
              me_, thread_id_, event_horizon.sec(), event_queue_.size(), epoch());
   while (!event_queue_.empty()){
+    if (!inbox_.empty()){
+      drainInbox();
+    }
     auto iter = event_queue_.begin();
     ExecutionEvent* ev = *iter;
     prll_debug("manager %d:%d pulled event %" PRIu32 " from link %" PRIu64 " at t=%10.7e on epoch %d",
@@ -194,18 +236,71 @@ EventManager::runEvents(Timestamp event_horizon)
 #endif
 
     if (ev->time() >= event_horizon){
+      flushOutbox();
       Timestamp ret = std::min(min_ipc_time_, ev->time());
       return ret;
+    } else if (batch_dispatch_){
+      now_ = ev->time();
+      auto end = iter;
+      do {
+        batch_.push_back(*end);
+        ++end;
+      } while (end != event_queue_.end() && (*end)->time() == now_);
+      event_queue_.erase(iter, end);
+      runBatch();
     } else {
       now_ = ev->time();
       event_queue_.erase(iter);
       ev->execute();
       delete ev;
+      ++num_events_run_;
     }
   }
+  flushOutbox();
   return min_ipc_time_;
 }
 
+void
+EventManager::runBatch()
+{
+  running_batch_ = true;
+  //the batch can grow while running if events schedule at the current time
+  for (batch_pos_=0; batch_pos_ < batch_.size(); ++batch_pos_){
+    ExecutionEvent* ev = batch_[batch_pos_];
+    if (batch_pos_ + 1 < batch_.size()){
+      __builtin_prefetch(batch_[batch_pos_+1]);
+    }
+    ev->execute();
+    delete ev;
+  }
+  running_batch_ = false;
+  ++num_batches_;
+  num_batched_events_ += batch_.size();
+  num_events_run_ += batch_.size();
+  max_batch_size_ = std::max(max_batch_size_, uint64_t(batch_.size()));
+  batch_.clear();
+}
+
+void
+EventManager::insertIntoBatch(ExecutionEvent* ev)
+{
+  //the event can only run after the one currently executing
+  auto iter = std::upper_bound(batch_.begin() + batch_pos_ + 1, batch_.end(), ev, EventCompare());
+  batch_.insert(iter, ev);
+}
+
+void
+EventManager::clearBatch()
+{
+  if (!running_batch_) return;
+
+  //keep the currently executing event, it gets deleted by runBatch
+  for (size_t i=batch_pos_+1; i < batch_.size(); ++i){
+    delete batch_[i];
+  }
+  batch_.resize(batch_pos_+1);
+}
+
 sw::ThreadContext*
 EventManager::cloneThread() const
 {
@@ -308,11 +403,11 @@ EventManager::scheduleIncoming(IpcEvent* iev)
   qev->setTime(iev->t);
   qev->setLink(iev->link);
 #if SSTMAC_SANITY_CHECK
-  size_t prev_size = event_queue_.size();
+  size_t prev_size = numEvents();
 #endif
   schedule(qev);
 #if SSTMAC_SANITY_CHECK
-  if (event_queue_.size() == prev_size){
+  if (numEvents() == prev_size){
     spkt_abort_printf("event queue lost event while scheduling! identical events added on link %" PRIu64, iev->link);
   }
 #endif
@@ -326,22 +421,52 @@ EventManager::registerPending()
   }
   pending_serialization_.clear();
 
-  int idx = 0;
-  for (auto& pendingVec : pending_events_[pendingSlot_]){
-    for (ExecutionEvent* ev : pendingVec){
+  drainInbox();
+}
+
+void
+EventManager::drainInbox()
+{
+  ExecutionEvent* ev;
+  while (inbox_.pop(ev)){
 #if SSTMAC_SANITY_CHECK
-      if (ev->time() < now_){
-        spkt_abort_printf("Thread %d scheduling event in the past on thread %d", idx, thread_id_);
-      }
+    if (ev->time() < now_){
+      spkt_abort_printf("scheduling event from another thread in the past on thread %d", thread_id_);
+    }
 #endif
-      prll_debug("manager %d:%d scheduling event %" PRIu32 " from link %" PRIu64 " at t=%10.7e on epoch %d from slot %d",
-                 me_, thread_id_, ev->seqnum(), ev->linkId(), ev->time().sec(), epoch(), pendingSlot_);
-      schedule(ev);
+    prll_debug("manager %d:%d scheduling event %" PRIu32 " from link %" PRIu64 " at t=%10.7e on epoch %d from inbox",
+               me_, thread_id_, ev->seqnum(), ev->linkId(), ev->time().sec(), epoch());
+    schedule(ev);
+  }
+}
+
+void
+EventManager::flushHeldEvents()
+{
+  has_held_events_ = false;
+  for (HeldEvents& held : outbox_){
+    size_t idx = 0;
+    while (idx < held.events.size() && held.dst->inbox_.push(held.events[idx])){
+      ++idx;
+    }
+    held.events.erase(held.events.begin(), held.events.begin() + idx);
+    if (!held.events.empty()){
+      //never spin on a full inbox - whatever is left goes over at the barrier
+      has_held_events_ = true;
     }
-    pendingVec.clear();
-    ++idx;
   }
-  pendingSlot_ = (pendingSlot_+1) % num_pendingSlots;
+}
+
+void
+EventManager::deliverHeldEvents()
+{
+  for (HeldEvents& held : outbox_){
+    for (ExecutionEvent* ev : held.events){
+      held.dst->schedule(ev);
+    }
+    held.events.clear();
+  }
+  has_held_events_ = false;
 }
 
 static int nactive_threads = 0;
@@ -421,7 +546,7 @@ EventManager::scheduleStop(Timestamp until)
   StopEvent* ev = new StopEvent(this);
   ev->setTime(until);
   ev->setSeqnum(0);
-  event_queue_.insert(ev);
+  schedule(ev);
 }
 
 Partition*
@@ -434,6 +559,17 @@ EventManager::topologyPartition() const
 void
 EventManager::finishStats()
 {
+  if (batch_dispatch_ && num_batches_ > 0){
+    cout0 << sprockit::sprintf("Event manager ran %" PRIu64 " events in %" PRIu64
+                               " same-time batches: average batch %8.3f, max batch %" PRIu64 "\n",
+                               num_batched_events_, num_batches_,
+                               double(num_batched_events_) / num_batches_, max_batch_size_);
+  }
+#if SSTMAC_CUSTOM_NEW
+  if (print_mem_pools_){
+    sprockit::ThreadAllocatorSet::printStats(cout0);
+  }
+#endif
 }
 
 void 
@@ -448,6 +584,8 @@ EventManager::schedule(ExecutionEvent* ev){
                "manager %d:%d adding event to run at t=%" PRIu64 " seqnum=%" PRIu32 " on link=%" PRIu64,
                me_, thread_id_, ev->time().time.ticks(), ev->seqnum(), ev->linkId());
 #endif
+  if (scheduleIntoBatch(ev)) return;
+
   event_queue_.insert(ev);
 #if SSTMAC_SANITY_CHECK
   if (prev_size == event_queue_.size()){
@@ -68,10 +68,12 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <sstmac/common/event_scheduler_fwd.h>
 #include <sstmac/backends/native/manager_fwd.h>
 #include <sstmac/common/sst_event.h>
+#include <sstmac/common/mpsc_ring.h>
 #include <sstmac/software/threading/threading_interface_fwd.h>
 
 #include <vector>
 #include <queue>
+#include <map>
 #include <cstdint>
 #include <cstddef>
 
@@ -140,7 +142,7 @@ class EventManager
 
   virtual void run();
 
-  void stop();
+  virtual void stop();
 
   Partition* topologyPartition() const;
 
@@ -189,19 +191,49 @@ class EventManager
 
   void ipcSchedule(IpcEvent* iev);
 
-  void multithreadSchedule(int slot, int srcThread, ExecutionEvent* ev){
-    pending_events_[slot][srcThread].push_back(ev);
+  /**
+   * @brief multithreadSend Deliver an event into the inbox of a manager on another thread.
+   *        If the inbox is full, the event is held here until flushOutbox.
+   * @param dst The manager that owns the destination thread
+   * @param ev
+   */
+  void multithreadSend(EventManager* dst, ExecutionEvent* ev){
+    HeldEvents& held = outbox_[dst->thread()];
+    if (!held.events.empty() || !dst->inbox_.push(ev)){
+      held.dst = dst;
+      held.events.push_back(ev);
+      has_held_events_ = true;
+    }
   }
 
-  void schedulePendingSerialization(char* buf){
-    pending_serialization_.push_back(buf);
+  /**
+   * @brief drainInbox Schedule all events that other threads have delivered so far.
+   *        Cross-thread events always arrive at or after the current horizon,
+   *        so this is safe at any point in an epoch.
+   *        Only called from the thread that owns this manager.
+   */
+  void drainInbox();
+
+  /**
+   * @brief flushOutbox Push any events held back because an inbox was full.
+   *        Does not block, events that still do not fit stay held.
+   */
+  void flushOutbox(){
+    if (has_held_events_) flushHeldEvents();
   }
 
-  int pendingSlot() const {
-    return pendingSlot_;
+  /**
+   * @brief deliverHeldEvents Schedule any events still held back directly
+   *        on their destination managers. Only called while all threads
+   *        are paused between epochs.
+   */
+  void deliverHeldEvents();
+
+  void schedulePendingSerialization(char* buf){
+    pending_serialization_.push_back(buf);
   }
 
-  void schedule(ExecutionEvent* ev);
+  virtual void schedule(ExecutionEvent* ev);
 
   void setInterconnect(hw::Interconnect* ic);
 
@@ -216,7 +248,7 @@ class EventManager
    * @param event_horizon
    * @return Whether no more events or just hit event horizon
    */
-  Timestamp runEvents(Timestamp event_horizon);
+  virtual Timestamp runEvents(Timestamp event_horizon);
 
   Timestamp now() const {
     return now_;
@@ -232,12 +264,24 @@ class EventManager
     min_ipc_time_ = std::min(t,min_ipc_time_);
   }
 
-  Timestamp minEventTime() const {
+  virtual Timestamp minEventTime() const {
     return event_queue_.empty()
           ? no_events_left_time
           : (*event_queue_.begin())->time();
   }
 
+  virtual size_t numEvents() const {
+    return event_queue_.size();
+  }
+
+  /**
+   * @brief numEventsRun
+   * @return The total number of events this manager has executed
+   */
+  uint64_t numEventsRun() const {
+    return num_events_run_;
+  }
+
   void setComponentManager(uint32_t comp_id, int thread){
     component_to_thread_[comp_id] = thread;
   }
@@ -247,18 +291,92 @@ class EventManager
     return threadManager(thread);
   }
 
-  void addLinkHandler(uint64_t linkId, EventHandler* handler);
+  /**
+   * @brief addLinkHandler Make a handler available for events arriving from another LP
+   * @param linkId    The id of the link the remote LP sends on
+   * @param handler   The handler to deliver arriving events to
+   * @param src_rank  The LP sending on the link
+   * @param latency   The latency of the link
+   */
+  void addLinkHandler(uint64_t linkId, EventHandler* handler, int src_rank, TimeDelta latency);
+
+  /**
+   * @brief addOutgoingLink Record a link from this LP to another LP
+   * @param dst_rank  The LP receiving on the link
+   * @param latency   The latency of the link
+   */
+  void addOutgoingLink(int dst_rank, TimeDelta latency);
+
+  /**
+   * @brief incomingLatencies
+   * @return The minimum link latency from each LP that has links into this one
+   */
+  const std::map<int,TimeDelta>& incomingLatencies() const {
+    return incoming_latencies_;
+  }
+
+  /**
+   * @brief outgoingLatencies
+   * @return The minimum link latency to each LP that this one has links to
+   */
+  const std::map<int,TimeDelta>& outgoingLatencies() const {
+    return outgoing_latencies_;
+  }
+
+  /**
+   * @brief minIncomingLatency
+   * @return The smallest latency on any link from another LP into this one,
+   *         zero if no remote links deliver to this manager
+   */
+  TimeDelta minIncomingLatency() const {
+    return min_incoming_latency_;
+  }
 
  protected:
   void registerPending();
 
+  /**
+   * @brief runBatch Execute all events in batch_, which share a single timestamp
+   * and are sorted in the same order as the event queue
+   */
+  void runBatch();
+
+  /**
+   * @brief scheduleIntoBatch
+   * Events scheduled at the current time while a batch is running must run
+   * in the same (link, seqnum) order as they would have from the event queue
+   * @return Whether the event was inserted into the running batch
+   */
+  bool scheduleIntoBatch(ExecutionEvent* ev){
+    if (running_batch_ && ev->time() == now_){
+      insertIntoBatch(ev);
+      return true;
+    }
+    return false;
+  }
+
+  void insertIntoBatch(ExecutionEvent* ev);
+
+  void clearBatch();
+
   virtual Timestamp receiveIncomingEvents(Timestamp vote) {
     return vote;
   }
 
-#define num_pendingSlots 4
-  int pendingSlot_;
-  std::vector<std::vector<ExecutionEvent*>> pending_events_[num_pendingSlots];
+  void flushHeldEvents();
+
+  /** Events from other threads, drained by this thread */
+  MpscRing<ExecutionEvent*> inbox_;
+
+  struct HeldEvents {
+    EventManager* dst;
+    std::vector<ExecutionEvent*> events;
+    HeldEvents() : dst(nullptr) {}
+  };
+  /** Events for other threads whose inboxes were full, indexed by destination thread */
+  std::vector<HeldEvents> outbox_;
+  bool has_held_events_;
+
   std::vector<char*> pending_serialization_;
 
  protected:
@@ -278,6 +396,9 @@ class EventManager
   uint16_t thread_id_;
 
   TimeDelta lookahead_;
+  TimeDelta min_incoming_latency_;
+  std::map<int,TimeDelta> incoming_latencies_;
+  std::map<int,TimeDelta> outgoing_latencies_;
   Timestamp now_;
 
  private:
@@ -287,6 +408,19 @@ class EventManager
  protected:
   Timestamp min_ipc_time_;
 
+  /** Pull all events with the same timestamp from the queue at once */
+  bool batch_dispatch_;
+  bool running_batch_;
+  size_t batch_pos_;
+  std::vector<ExecutionEvent*> batch_;
+  uint64_t num_batches_;
+  uint64_t num_batched_events_;
+  uint64_t max_batch_size_;
+
+  uint64_t num_events_run_;
+
+  bool print_mem_pools_;
+
   void finalizeStatsOutput();
 
   void finalizeStatsInit();
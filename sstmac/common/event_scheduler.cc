@@ -193,6 +193,20 @@ LocalLink::send(TimeDelta delay, Event *ev)
   mgr_->schedule(qev);
 }
 
+IpcLink::IpcLink(uint64_t linkId, TimeDelta latency,
+                 int rank, int thread,
+                 EventManager* src_mgr,
+                 EventManager* ipc_mgr) :
+  EventLink(linkId, latency),
+  rank_(rank),
+  thread_(thread),
+  ev_mgr_(src_mgr),
+  ipc_mgr_(ipc_mgr)
+{
+  setMinRemoteLatency(latency);
+  src_mgr->addOutgoingLink(rank, latency);
+}
+
 void
 IpcLink::send(TimeDelta delay, Event *ev)
 {
@@ -227,7 +241,7 @@ MultithreadLink::send(TimeDelta delay, Event* ev)
   qev->setTime(arrival);
   qev->setSeqnum(seqnum_++);
   qev->setLink(linkId_);
-  dst_mgr_->multithreadSchedule(mgr_->pendingSlot(), mgr_->thread(), qev);
+  mgr_->multithreadSend(dst_mgr_, qev);
 }
 
 void
@@ -569,15 +569,7 @@ class IpcLink : public EventLink {
          TimeDelta latency,
          int rank, int thread,
          EventManager* src_mgr,
-         EventManager* ipc_mgr) :
-    EventLink(linkId, latency),
-    rank_(rank),
-    thread_(thread),
-    ev_mgr_(src_mgr),
-    ipc_mgr_(ipc_mgr)
-  {
-    setMinRemoteLatency(latency);
-  }
+         EventManager* ipc_mgr);
 
   std::string toString() const override {
     return "ipc link";
@@ -0,0 +1,317 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef SSTMAC_COMMON_LADDER_QUEUE_H_INCLUDED
+#define SSTMAC_COMMON_LADDER_QUEUE_H_INCLUDED
+
+#include <sstmac/common/sst_event.h>
+#include <sprockit/errors.h>
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+
+namespace sstmac {
+
+/**
+ * @brief The LadderQueue class
+ * A ladder queue (Tang, Goh, Thng 2005) for execution events.
+ * Events far in the future sit unsorted in the top list. They are
+ * spread across rungs of time buckets as the simulation approaches them,
+ * and only the bucket about to run is sorted into the bottom list.
+ * Enqueue and dequeue are amortized O(1) instead of O(log n).
+ * The bottom list is sorted with the full Compare (time, link, seqnum),
+ * so events come out in exactly the same order as a sorted set.
+ * Bucketing only uses the tick count of the timestamp - in the native
+ * build Timestamp::epochs never carries (carry_bits_mask is zero).
+ */
+template <class Compare>
+class LadderQueue
+{
+ public:
+  using tick_t = uint64_t;
+
+  /** Buckets bigger than this get split into a new rung rather than sorted */
+  static constexpr size_t split_threshold = 50;
+  static constexpr size_t max_rungs = 8;
+
+  LadderQueue() :
+    size_(0),
+    num_rungs_(0),
+    top_start_(0),
+    top_min_(std::numeric_limits<tick_t>::max()),
+    top_max_(0)
+  {
+    rungs_.resize(max_rungs);
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  void push(ExecutionEvent* ev){
+    ++size_;
+    tick_t t = ticks(ev);
+    if (t >= top_start_){
+      top_.push_back(ev);
+      top_min_ = std::min(top_min_, t);
+      top_max_ = std::max(top_max_, t);
+      return;
+    }
+
+    for (size_t i=0; i < num_rungs_; ++i){
+      Rung& r = rungs_[i];
+      if (t >= r.currentStart()){
+        r.add(ev, t);
+        return;
+      }
+    }
+
+    insertBottom(ev);
+  }
+
+  /**
+   * @return The next event to run. The queue must not be empty.
+   */
+  ExecutionEvent* top(){
+    if (bottom_.empty()) refillBottom();
+    return bottom_.back();
+  }
+
+  /**
+   * Remove the event returned by the last call to top()
+   */
+  void pop(){
+    bottom_.pop_back();
+    --size_;
+  }
+
+  /**
+   * Remove all events with the same timestamp as top() and append them
+   * to batch in execution order. The queue must not be empty.
+   * All events at a given tick always land in the same bucket,
+   * so they are all in the bottom list together.
+   */
+  void popBatch(std::vector<ExecutionEvent*>& batch){
+    if (bottom_.empty()) refillBottom();
+    Timestamp t = bottom_.back()->time();
+    do {
+      batch.push_back(bottom_.back());
+      bottom_.pop_back();
+      --size_;
+    } while (!bottom_.empty() && bottom_.back()->time() == t);
+  }
+
+  template <class Fxn>
+  void forEach(Fxn&& fxn){
+    for (ExecutionEvent* ev : bottom_) fxn(ev);
+    for (size_t i=0; i < num_rungs_; ++i){
+      for (auto& bucket : rungs_[i].buckets){
+        for (ExecutionEvent* ev : bucket) fxn(ev);
+      }
+    }
+    for (ExecutionEvent* ev : top_) fxn(ev);
+  }
+
+  void clear(){
+    bottom_.clear();
+    for (size_t i=0; i < num_rungs_; ++i){
+      rungs_[i].clear();
+    }
+    num_rungs_ = 0;
+    top_.clear();
+    top_start_ = 0;
+    top_min_ = std::numeric_limits<tick_t>::max();
+    top_max_ = 0;
+    size_ = 0;
+  }
+
+ private:
+  struct Rung {
+    tick_t start;
+    tick_t end;
+    tick_t width;
+    size_t current;
+    size_t count;
+    std::vector<std::vector<ExecutionEvent*>> buckets;
+
+    tick_t currentStart() const {
+      return std::min(start + current * width, end);
+    }
+
+    void init(tick_t rstart, tick_t rwidth, size_t nbuckets){
+      start = rstart;
+      end = saturatingAdd(rstart, nbuckets * rwidth);
+      width = rwidth;
+      current = 0;
+      count = 0;
+      //keep the allocated bucket vectors around for reuse
+      if (buckets.size() < nbuckets) buckets.resize(nbuckets);
+      else buckets.erase(buckets.begin() + nbuckets, buckets.end());
+    }
+
+    void add(ExecutionEvent* ev, tick_t t){
+      //the last bucket is a catch-all if the rung range saturated
+      size_t idx = std::min(size_t((t - start) / width), buckets.size() - 1);
+      buckets[idx].push_back(ev);
+      ++count;
+    }
+
+    void clear(){
+      for (auto& b : buckets) b.clear();
+      count = 0;
+      current = 0;
+    }
+  };
+
+  static tick_t ticks(ExecutionEvent* ev){
+#if SSTMAC_SANITY_CHECK
+    if (ev->time().epochs != 0){
+      spkt_abort_printf("LadderQueue: cannot bucket events with non-zero epoch");
+    }
+#endif
+    return ev->time().time.ticks();
+  }
+
+  static tick_t saturatingAdd(tick_t a, tick_t b){
+    tick_t sum = a + b;
+    return sum < a ? std::numeric_limits<tick_t>::max() : sum;
+  }
+
+  /** The bottom is sorted in reverse order so the next event pops off the back */
+  static bool reverseLess(ExecutionEvent* lhs, ExecutionEvent* rhs){
+    return Compare()(rhs, lhs);
+  }
+
+  void insertBottom(ExecutionEvent* ev){
+    auto iter = std::lower_bound(bottom_.begin(), bottom_.end(), ev, &LadderQueue::reverseLess);
+    bottom_.insert(iter, ev);
+  }
+
+  void spawnRung(tick_t start, tick_t width, std::vector<ExecutionEvent*>& evs){
+    Rung& r = rungs_[num_rungs_++];
+    size_t nbuckets = evs.size();
+    tick_t rwidth = width / nbuckets + (width % nbuckets ? 1 : 0);
+    if (rwidth == 0) rwidth = 1;
+    nbuckets = width / rwidth + (width % rwidth ? 1 : 0);
+    r.init(start, rwidth, std::max(nbuckets, size_t(1)));
+    for (ExecutionEvent* ev : evs){
+      r.add(ev, ticks(ev));
+    }
+    evs.clear();
+  }
+
+  void spawnRungFromTop(){
+    size_t nevents = top_.size();
+    tick_t range = top_max_ - top_min_;
+    tick_t width = range / nevents + 1;
+    //the rung covers [top_min_, top_min_ + nevents*width) > top_max_
+    Rung& r = rungs_[num_rungs_++];
+    r.init(top_min_, width, nevents);
+    for (ExecutionEvent* ev : top_){
+      r.add(ev, ticks(ev));
+    }
+    top_.clear();
+    top_start_ = r.end;
+    top_min_ = std::numeric_limits<tick_t>::max();
+    top_max_ = 0;
+  }
+
+  void refillBottom(){
+    if (num_rungs_ == 0){
+      spawnRungFromTop();
+    }
+
+    while (true){
+      Rung& r = rungs_[num_rungs_ - 1];
+      if (r.count == 0){
+        r.clear();
+        --num_rungs_;
+        if (num_rungs_ == 0){
+          spawnRungFromTop();
+        }
+        continue;
+      }
+
+      while (r.buckets[r.current].empty()) ++r.current;
+
+      std::vector<ExecutionEvent*>& bucket = r.buckets[r.current];
+      tick_t bucketStart = r.currentStart();
+      ++r.current;
+      r.count -= bucket.size();
+      //a saturated last bucket is a catch-all and has no fixed width
+      bool canSplit = r.width > 1 && num_rungs_ < max_rungs
+          && r.width <= r.end - bucketStart;
+      if (bucket.size() > split_threshold && canSplit){
+        spawnRung(bucketStart, r.width, bucket);
+      } else {
+        bottom_.swap(bucket);
+        std::sort(bottom_.begin(), bottom_.end(), &LadderQueue::reverseLess);
+        return;
+      }
+    }
+  }
+
+  size_t size_;
+
+  std::vector<ExecutionEvent*> bottom_;
+
+  std::vector<Rung> rungs_;
+  size_t num_rungs_;
+
+  std::vector<ExecutionEvent*> top_;
+  tick_t top_start_;
+  tick_t top_min_;
+  tick_t top_max_;
+
+};
+
+}
+
+#endif
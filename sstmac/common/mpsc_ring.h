@@ -0,0 +1,177 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef SSTMAC_COMMON_MPSC_RING_H_INCLUDED
+#define SSTMAC_COMMON_MPSC_RING_H_INCLUDED
+
+#include <sprockit/errors.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace sstmac {
+
+/**
+ * @brief The MpscRing class
+ * A bounded lock-free ring buffer that any number of threads can push into
+ * and a single owner thread pops from (Vyukov's bounded queue).
+ * Each cell carries a sequence number that tells producers and the consumer
+ * whether the cell is free for the current lap around the ring.
+ * Pushing into a full ring fails rather than blocking so the producer can
+ * keep the item and retry later.
+ */
+template <class T>
+class MpscRing
+{
+ public:
+  MpscRing() :
+    cells_(nullptr),
+    mask_(0),
+    tail_(0),
+    head_(0)
+  {
+  }
+
+  ~MpscRing(){
+    if (cells_) delete[] cells_;
+  }
+
+  /**
+   * @brief init Allocate the ring. Not thread-safe, must be done before any push or pop
+   * @param capacity  The number of items, rounded up to a power of two
+   */
+  void init(size_t capacity){
+    if (cells_){
+      spkt_abort_printf("MpscRing initialized twice");
+    }
+    size_t size = 2;
+    while (size < capacity) size *= 2;
+    cells_ = new Cell[size];
+    mask_ = size - 1;
+    for (size_t i=0; i < size; ++i){
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    tail_.store(0, std::memory_order_relaxed);
+    head_ = 0;
+  }
+
+  size_t capacity() const {
+    return mask_ + 1;
+  }
+
+  /**
+   * @brief push Called from any thread
+   * @return Whether the item was added, false if the ring is full
+   */
+  bool push(T t){
+    Cell* cell;
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true){
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t diff = intptr_t(seq) - intptr_t(pos);
+      if (diff == 0){
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+          break;
+        }
+      } else if (diff < 0){
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = t;
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief pop Only called from the owning thread
+   * @return Whether an item was removed, false if the ring is empty
+   */
+  bool pop(T& t){
+    if (!cells_) return false;
+    Cell* cell = &cells_[head_ & mask_];
+    size_t seq = cell->seq.load(std::memory_order_acquire);
+    if (seq != head_ + 1){
+      return false;
+    }
+    t = cell->data;
+    cell->seq.store(head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    return true;
+  }
+
+  /**
+   * @brief empty Only meaningful on the owning thread. Items pushed
+   *        concurrently may or may not be seen.
+   */
+  bool empty() const {
+    if (!cells_) return true;
+    const Cell* cell = &cells_[head_ & mask_];
+    return cell->seq.load(std::memory_order_acquire) != head_ + 1;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    T data;
+  };
+
+  static constexpr int cache_line_size = 64;
+
+  Cell* cells_;
+  size_t mask_;
+  //keep producers and the consumer off each other's cache lines
+  char pad0_[cache_line_size];
+  std::atomic<size_t> tail_;
+  char pad1_[cache_line_size];
+  size_t head_;
+
+};
+
+}
+
+#endif
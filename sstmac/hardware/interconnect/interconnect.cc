@@ -364,7 +364,7 @@ Interconnect::connectLogP(
             interconn_debug("making NIC %d payload handler available on link %" PRIu64,
                             nd->addr(), linkId);
             auto* handler = nd->payloadHandler(NIC::LogP);
-            mgr->threadManager(target_thread)->addLinkHandler(linkId++, handler);
+            mgr->threadManager(target_thread)->addLinkHandler(linkId++, handler, rank, logp_link_latency);
           } else {
             //increment to keep numbering consistent
             linkId++;
@@ -402,7 +402,7 @@ Interconnect::connectLogP(
             interconn_debug("making NIC %d payload handler available on link %" PRIu64,
                             nd->addr(), linkId);
             auto* handler = nd->payloadHandler(NIC::LogP);
-            mgr->threadManager(target_thread)->addLinkHandler(linkId++, handler);
+            mgr->threadManager(target_thread)->addLinkHandler(linkId++, handler, rank, logp_link_latency);
           } else {
             //increment to keep numbering consistent
             linkId++;
@@ -549,7 +549,7 @@ Interconnect::connectSwitches(uint64_t linkIdOffset, EventManager* mgr, SST::Par
         auto* payload_handler = switches_[conn.dst]->payloadHandler(conn.dst_inport);
         interconn_debug("switch %d:%d making payload handler available on IPC link %" PRIu64,
                          conn.dst, conn.dst_inport, linkId);
-        mgr->threadManager(dst_thread)->addLinkHandler(linkId, payload_handler);
+        mgr->threadManager(dst_thread)->addLinkHandler(linkId, payload_handler, src_rank, linkLatency);
       }
 
       if (src_rank == my_rank){
@@ -581,7 +581,7 @@ Interconnect::connectSwitches(uint64_t linkIdOffset, EventManager* mgr, SST::Par
         auto* credit_handler = switches_[conn.src]->creditHandler(conn.src_outport);
         interconn_debug("switch %d:%d making payload handler available on IPC link %" PRIu64,
                          conn.src, conn.src_outport, linkId);
-        mgr->threadManager(src_thread)->addLinkHandler(linkId, credit_handler);
+        mgr->threadManager(src_thread)->addLinkHandler(linkId, credit_handler, dst_rank, linkLatency);
       }
 
       if (dst_rank == my_rank){
@@ -69,7 +69,9 @@ class UnblockEvent :
 
 };
 
-class TimeoutEvent : public ExecutionEvent
+class TimeoutEvent :
+  public ExecutionEvent,
+  public sprockit::thread_safe_new<TimeoutEvent>
 {
 
  public:
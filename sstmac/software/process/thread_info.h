@@ -70,6 +70,16 @@ class ThreadInfo {
     return *tls;
   }
 
+  /**
+   * @brief setCurrentPhysicalThreadId Change the thread id stored on the current stack.
+   *        Used when a worker thread switches between thread work units.
+   */
+  static inline void setCurrentPhysicalThreadId(int thr){
+    uintptr_t localStorage = get_sstmac_tls();
+    int* tls = (int*) (localStorage + SSTMAC_TLS_THREAD_ID);
+    *tls = thr;
+  }
+
 };
 
 }